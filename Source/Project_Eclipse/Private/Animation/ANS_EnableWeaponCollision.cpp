@@ -1,65 +1,37 @@
 #include "Animation/ANS_EnableWeaponCollision.h"
-#include "Characters/MyCharacter.h"
-#include "Characters/BaseCharacter.h"
-#include "Enemy/Enemy.h"
-#include "Weapons/Weapon.h"
-#include "Components/BoxComponent.h"
-#include "Engine/Engine.h"
+#include "Interfaces/Combatant.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Diagnostics/EclipseLog.h"
 
 void UANS_EnableWeaponCollision::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration)
 {
-    GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Magenta, TEXT("ANIMATION NOTIFY: EnableWeaponCollision BEGIN"));
+    ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Magenta, TEXT("ANIMATION NOTIFY: EnableWeaponCollision BEGIN"));
     
-    if (ABaseCharacter* Character = Cast<ABaseCharacter>(MeshComp->GetOwner()))
+    // Each character type opens its own window (new swing, latency mark) behind the virtual
+    if (ICombatant* Combatant = ICombatant::Resolve(MeshComp->GetOwner()))
     {
-        if (AMyCharacter* MyCharacter = Cast<AMyCharacter>(Character))
-        {
-            // For player character
-            MyCharacter->EnableWeaponCollision();
-            
-            // Clear hit actors when starting weapon collision
-            MyCharacter->ClearWeaponHitActors();
-            
-            UE_LOG(LogTemp, Warning, TEXT("EnableWeaponCollision: Player weapon collision enabled"));
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, TEXT("PLAYER WEAPON COLLISION ENABLED"));
-        }
-        else if (AEnemy* Enemy = Cast<AEnemy>(Character))
-        {
-            // For enemy
-            Enemy->SetWeaponCollisionEnabled(ECollisionEnabled::QueryOnly);
-            UE_LOG(LogTemp, Warning, TEXT("EnableWeaponCollision: Enemy weapon collision enabled"));
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green, TEXT("ENEMY WEAPON COLLISION ENABLED"));
-        }
+        Combatant->EnableWeaponCollision();
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("EnableWeaponCollision: %s weapon collision enabled"), *GetNameSafe(MeshComp->GetOwner()));
+        ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Green, TEXT("WEAPON COLLISION ENABLED"));
     }
     else
     {
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ANIMATION NOTIFY: No BaseCharacter found"));
+        ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Red, TEXT("ANIMATION NOTIFY: No combatant found"));
     }
 }
 
 void UANS_EnableWeaponCollision::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
 {
-    GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Magenta, TEXT("ANIMATION NOTIFY: EnableWeaponCollision END"));
+    ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Magenta, TEXT("ANIMATION NOTIFY: EnableWeaponCollision END"));
     
-    if (ABaseCharacter* Character = Cast<ABaseCharacter>(MeshComp->GetOwner()))
+    if (ICombatant* Combatant = ICombatant::Resolve(MeshComp->GetOwner()))
     {
-        if (AMyCharacter* MyCharacter = Cast<AMyCharacter>(Character))
-        {
-            // For player character
-            MyCharacter->DisableWeaponCollision();
-            UE_LOG(LogTemp, Warning, TEXT("EnableWeaponCollision: Player weapon collision disabled"));
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("PLAYER WEAPON COLLISION DISABLED"));
-        }
-        else if (AEnemy* Enemy = Cast<AEnemy>(Character))
-        {
-            // For enemy
-            Enemy->SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
-            UE_LOG(LogTemp, Warning, TEXT("EnableWeaponCollision: Enemy weapon collision disabled"));
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("ENEMY WEAPON COLLISION DISABLED"));
-        }
+        Combatant->DisableWeaponCollision();
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("EnableWeaponCollision: %s weapon collision disabled"), *GetNameSafe(MeshComp->GetOwner()));
+        ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Orange, TEXT("WEAPON COLLISION DISABLED"));
     }
     else
     {
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("ANIMATION NOTIFY END: No BaseCharacter found"));
+        ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Red, TEXT("ANIMATION NOTIFY END: No combatant found"));
     }
-} 
\ No newline at end of file
+}
@@ -0,0 +1,205 @@
+#include "Animation/AttackTrajectoryAsset.h"
+#include "Diagnostics/EclipseLog.h"
+
+#if WITH_EDITOR
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Weapons/Weapon.h"
+#endif
+
+const FName UAttackTrajectoryAsset::BladeTrackName(TEXT("Blade"));
+
+UAttackTrajectoryAsset::UAttackTrajectoryAsset()
+{
+#if WITH_EDITORONLY_DATA
+	SectionNames = { FName("Attack1"), FName("Attack2"), FName("Attack3") };
+
+	FAttackTrajectoryTrackSource& Blade = TrackSources.AddDefaulted_GetRef();
+	Blade.TrackName = BladeTrackName;
+	Blade.Socket = FName("hand_r");
+	Blade.bUseWeaponBlade = true;
+
+	FAttackTrajectoryTrackSource& FootLeft = TrackSources.AddDefaulted_GetRef();
+	FootLeft.TrackName = FName("FootL");
+	FootLeft.Socket = FName("foot_l");
+
+	FAttackTrajectoryTrackSource& FootRight = TrackSources.AddDefaulted_GetRef();
+	FootRight.TrackName = FName("FootR");
+	FootRight.Socket = FName("foot_r");
+#endif
+}
+
+const FAttackTrajectorySection* UAttackTrajectoryAsset::FindSection(FName SectionName) const
+{
+	return Sections.FindByPredicate([SectionName](const FAttackTrajectorySection& Section) { return Section.SectionName == SectionName; });
+}
+
+bool UAttackTrajectoryAsset::SampleSegment(const FAttackTrajectorySection& Section, int32 TrackIndex, float Time, FVector& OutStart, FVector& OutEnd) const
+{
+	if (!TrackNames.IsValidIndex(TrackIndex) || Section.NumFrames == 0 || SampleInterval <= 0.f || Time < 0.f || Time > Section.Duration)
+	{
+		return false;
+	}
+
+	const float Frame = FMath::Min(Time / SampleInterval, static_cast<float>(Section.NumFrames - 1));
+	const int32 Frame0 = FMath::FloorToInt(Frame);
+	const int32 Frame1 = FMath::Min(Frame0 + 1, Section.NumFrames - 1);
+	const float Alpha = Frame - Frame0;
+
+	const int32 Stride = TrackNames.Num() * 2;
+	const int32 Index0 = Frame0 * Stride + TrackIndex * 2;
+	const int32 Index1 = Frame1 * Stride + TrackIndex * 2;
+	if (!Section.Points.IsValidIndex(Index1 + 1))
+	{
+		return false;
+	}
+
+	OutStart = FVector(FMath::Lerp(Section.Points[Index0], Section.Points[Index1], Alpha));
+	OutEnd = FVector(FMath::Lerp(Section.Points[Index0 + 1], Section.Points[Index1 + 1], Alpha));
+	return true;
+}
+
+#if WITH_EDITOR
+namespace
+{
+	struct FResolvedTrack
+	{
+		int32 BoneIndex = INDEX_NONE;
+		FTransform SocketLocal = FTransform::Identity;
+		FVector LocalStart = FVector::ZeroVector;
+		FVector LocalEnd = FVector::ZeroVector;
+	};
+
+	// Walks up the hierarchy from the bone; bones without a track in the sequence keep the reference pose
+	FTransform GetComponentSpaceBoneTransform(const UAnimSequence* Sequence, const FReferenceSkeleton& RefSkeleton, double Time, int32 BoneIndex)
+	{
+		const FAnimExtractContext ExtractContext(Time);
+		FTransform Result = FTransform::Identity;
+		for (int32 Index = BoneIndex; Index != INDEX_NONE; Index = RefSkeleton.GetParentIndex(Index))
+		{
+			FTransform Local = RefSkeleton.GetRefBonePose()[Index];
+			if (Sequence)
+			{
+				Sequence->GetBoneTransform(Local, FSkeletonPoseBoneIndex(Index), ExtractContext, false);
+			}
+			Result = Result * Local;
+		}
+		return Result;
+	}
+}
+
+void UAttackTrajectoryAsset::Bake()
+{
+	Modify();
+
+	FString Error;
+	if (BakeFromMontage(Error))
+	{
+		UE_LOG(LogEclipse, Display, TEXT("%s: Baked %d sections, %d tracks"), *GetName(), Sections.Num(), TrackNames.Num());
+	}
+	else
+	{
+		UE_LOG(LogEclipse, Error, TEXT("%s: Bake failed: %s"), *GetName(), *Error);
+	}
+}
+
+bool UAttackTrajectoryAsset::BakeFromMontage(FString& OutError)
+{
+	if (!Montage || !Montage->GetSkeleton() || Montage->SlotAnimTracks.Num() == 0)
+	{
+		OutError = TEXT("Montage with a skeleton and a slot track is required");
+		return false;
+	}
+
+	const USkeleton* Skeleton = Montage->GetSkeleton();
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+
+	TArray<FResolvedTrack> Tracks;
+	TArray<FName> NewTrackNames;
+	for (const FAttackTrajectoryTrackSource& Source : TrackSources)
+	{
+		FResolvedTrack& Track = Tracks.AddDefaulted_GetRef();
+		NewTrackNames.Add(Source.TrackName);
+
+		FName BoneName = Source.Socket;
+		if (const USkeletalMeshSocket* Socket = Skeleton->FindSocket(Source.Socket))
+		{
+			BoneName = Socket->BoneName;
+			Track.SocketLocal = Socket->GetSocketLocalTransform();
+		}
+
+		Track.BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+		if (Track.BoneIndex == INDEX_NONE)
+		{
+			OutError = FString::Printf(TEXT("No socket or bone %s on %s"), *Source.Socket.ToString(), *Skeleton->GetName());
+			return false;
+		}
+
+		Track.LocalStart = Source.LocalStart;
+		Track.LocalEnd = Source.LocalEnd;
+		if (Source.bUseWeaponBlade)
+		{
+			const AWeapon* Weapon = WeaponClass ? WeaponClass->GetDefaultObject<AWeapon>() : nullptr;
+			if (!Weapon)
+			{
+				OutError = FString::Printf(TEXT("Track %s uses the weapon blade but WeaponClass is not set"), *Source.TrackName.ToString());
+				return false;
+			}
+			Weapon->GetBladeLocalSegment(Track.LocalStart, Track.LocalEnd);
+		}
+	}
+
+	const FAnimTrack& AnimTrack = Montage->SlotAnimTracks[0].AnimTrack;
+	const float Interval = 1.f / FMath::Max(SampleRate, 1.f);
+
+	TArray<FAttackTrajectorySection> NewSections;
+	for (const FName SectionName : SectionNames)
+	{
+		const int32 SectionIndex = Montage->GetSectionIndex(SectionName);
+		if (SectionIndex == INDEX_NONE)
+		{
+			UE_LOG(LogEclipse, Warning, TEXT("%s: %s has no section %s"), *GetName(), *Montage->GetName(), *SectionName.ToString());
+			continue;
+		}
+
+		float StartTime = 0.f;
+		float EndTime = 0.f;
+		Montage->GetSectionStartAndEndTime(SectionIndex, StartTime, EndTime);
+
+		FAttackTrajectorySection& Section = NewSections.AddDefaulted_GetRef();
+		Section.SectionName = SectionName;
+		Section.Duration = EndTime - StartTime;
+		Section.NumFrames = FMath::FloorToInt(Section.Duration / Interval) + 1;
+		Section.Points.Reserve(Section.NumFrames * Tracks.Num() * 2);
+
+		for (int32 Frame = 0; Frame < Section.NumFrames; ++Frame)
+		{
+			const float TrackTime = StartTime + FMath::Min(Frame * Interval, Section.Duration);
+			const FAnimSegment* Segment = AnimTrack.GetSegmentAtTime(TrackTime);
+			const UAnimSequence* Sequence = Segment ? Cast<UAnimSequence>(Segment->GetAnimReference()) : nullptr;
+			const double AnimTime = Segment ? Segment->ConvertTrackPosToAnimPos(TrackTime) : 0.0;
+
+			for (const FResolvedTrack& Track : Tracks)
+			{
+				const FTransform SocketTransform = Track.SocketLocal * GetComponentSpaceBoneTransform(Sequence, RefSkeleton, AnimTime, Track.BoneIndex);
+				Section.Points.Add(FVector3f(SocketTransform.TransformPosition(Track.LocalStart)));
+				Section.Points.Add(FVector3f(SocketTransform.TransformPosition(Track.LocalEnd)));
+			}
+		}
+	}
+
+	if (NewSections.Num() == 0)
+	{
+		OutError = TEXT("None of the sections were found in the montage");
+		return false;
+	}
+
+	TrackNames = MoveTemp(NewTrackNames);
+	SampleInterval = Interval;
+	Sections = MoveTemp(NewSections);
+	MarkPackageDirty();
+	return true;
+}
+#endif
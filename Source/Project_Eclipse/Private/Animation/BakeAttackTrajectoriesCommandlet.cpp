@@ -0,0 +1,65 @@
+#include "Animation/BakeAttackTrajectoriesCommandlet.h"
+#include "Animation/AttackTrajectoryAsset.h"
+#include "Diagnostics/EclipseLog.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+#endif
+
+UBakeAttackTrajectoriesCommandlet::UBakeAttackTrajectoriesCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBakeAttackTrajectoriesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UAttackTrajectoryAsset::StaticClass()->GetClassPathName(), Assets);
+
+	int32 Failures = 0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		UAttackTrajectoryAsset* Asset = Cast<UAttackTrajectoryAsset>(AssetData.GetAsset());
+		if (!Asset)
+		{
+			continue;
+		}
+
+		FString Error;
+		if (!Asset->BakeFromMontage(Error))
+		{
+			UE_LOG(LogEclipse, Error, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Error);
+			++Failures;
+			continue;
+		}
+
+		UPackage* Package = Asset->GetPackage();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		if (!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+		{
+			UE_LOG(LogEclipse, Error, TEXT("Could not save %s"), *Filename);
+			++Failures;
+			continue;
+		}
+
+		UE_LOG(LogEclipse, Display, TEXT("Baked %s"), *AssetData.GetObjectPathString());
+	}
+
+	UE_LOG(LogEclipse, Display, TEXT("BakeAttackTrajectories: %d assets, %d failed"), Assets.Num(), Failures);
+	return Failures > 0 ? 1 : 0;
+#else
+	UE_LOG(LogEclipse, Error, TEXT("BakeAttackTrajectories needs an editor build"));
+	return 1;
+#endif
+}
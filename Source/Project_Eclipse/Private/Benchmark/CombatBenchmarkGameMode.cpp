@@ -0,0 +1,585 @@
+#include "Benchmark/CombatBenchmarkGameMode.h"
+#include "Characters/MyCharacter.h"
+#include "Enemy/Enemy.h"
+#include "Weapons/Weapon.h"
+#include "Components/WeaponComponent.h"
+#include "Combat/EclipseCollision.h"
+#include "Combat/CombatActorPoolSubsystem.h"
+#include "Combat/CombatAssetSubsystem.h"
+#include "HUD/MainHUD.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/DamageType.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+
+ACombatBenchmarkGameMode::ACombatBenchmarkGameMode()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	DefaultPawnClass = AMyCharacter::StaticClass();
+	HUDClass = AMainHUD::StaticClass();
+	EnemyClass = AEnemy::StaticClass();
+}
+
+void ACombatBenchmarkGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ParseCommandLine();
+
+	if (FApp::IsUnattended())
+	{
+		bExitWhenDone = true;
+	}
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &ACombatBenchmarkGameMode::OnWorldTickStart);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ACombatBenchmarkGameMode::OnEndFrame);
+}
+
+void ACombatBenchmarkGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	// Still report whatever was captured if the run was cut short
+	if (bStarted && !bFinished)
+	{
+		FinishBenchmark();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatBenchmarkGameMode::ParseCommandLine()
+{
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("EclipseBenchEnemies="), NumEnemies);
+	FParse::Value(CommandLine, TEXT("EclipseBenchWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("EclipseBenchDuration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("EclipseBenchCSV="), OutputFile);
+
+	FString EnemyClassPath;
+	if (FParse::Value(CommandLine, TEXT("EclipseBenchEnemyClass="), EnemyClassPath))
+	{
+		if (UClass* LoadedClass = LoadClass<AEnemy>(nullptr, *EnemyClassPath))
+		{
+			EnemyClass = LoadedClass;
+		}
+		else
+		{
+			UE_LOG(LogEclipse, Error, TEXT("CombatBenchmark: Could not load enemy class %s"), *EnemyClassPath);
+		}
+	}
+
+	NumEnemies = FMath::Max(NumEnemies, 0);
+	NumPatrolPoints = FMath::Max(NumPatrolPoints, 2);
+}
+
+void ACombatBenchmarkGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	// The player pawn may be spawned after our BeginPlay, so start once it exists
+	if (!bStarted)
+	{
+		if (AMyCharacter* Player = Cast<AMyCharacter>(UGameplayStatics::GetPlayerPawn(this, 0)))
+		{
+			StartBenchmark(Player);
+		}
+		return;
+	}
+
+	ElapsedSeconds += DeltaSeconds;
+
+	// Budget samples and allocation counts only count once the warmup is over
+	if (!bBudgetWindowOpen && ElapsedSeconds >= WarmupSeconds)
+	{
+		bBudgetWindowOpen = true;
+		OverlapCallbacksAtWindowStart = FEclipseCollision::GetOverlapCallbackCount();
+#if ECLIPSE_WITH_PERF_BUDGETS
+		FEclipsePerfBudgets::BeginWindow();
+#endif
+#if ECLIPSE_WITH_ALLOC_TRACKING
+		FEclipseAllocTracking::BeginWindow();
+#endif
+#if ECLIPSE_WITH_LATENCY_TRACKING
+		FCombatLatencyTracker::Get().Reset();
+#endif
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < EnemySlots.Num(); ++SlotIndex)
+	{
+		TickEnemySlot(EnemySlots[SlotIndex], SlotIndex, DeltaSeconds);
+	}
+
+	if (LaunchToPlayableMs < 0.0 && IsPlayable())
+	{
+		LaunchToPlayableMs = (FPlatformTime::Seconds() - GStartTime) * 1000.0;
+		UE_LOG(LogEclipse, Display, TEXT("CombatBenchmark: Playable %.0f ms after launch (%s combat assets)"),
+			LaunchToPlayableMs, *UCombatAssetSubsystem::GetLoadingModeLabel());
+
+		// The player's weapon class may come from its combat asset set
+		EquipPlayerWeapon(PlayerCharacter);
+	}
+
+	if (PlayerCharacter && PlayerAttackInterval > 0.f && LaunchToPlayableMs >= 0.0)
+	{
+		PlayerAttackTimer += DeltaSeconds;
+		if (PlayerAttackTimer >= PlayerAttackInterval)
+		{
+			PlayerAttackTimer = 0.f;
+			PlayerCharacter->Attack1();
+
+			if (FirstAttackWindowEnd < 0.f)
+			{
+				FirstAttackWindowEnd = ElapsedSeconds + FirstAttackWindowSeconds;
+				FirstAttackMaxFrameMs = 0.f;
+			}
+		}
+	}
+
+	if (ElapsedSeconds >= WarmupSeconds + DurationSeconds)
+	{
+		FinishBenchmark();
+	}
+}
+
+void ACombatBenchmarkGameMode::StartBenchmark(AMyCharacter* Player)
+{
+	bStarted = true;
+	PlayerCharacter = Player;
+	UCombatAssetSubsystem::PreloadCharacterClass(this, EnemyClass);
+
+	const FVector Center = Player->GetActorLocation();
+
+	// Patrol points on an inner ring so enemies walk past each other while patrolling
+	for (int32 PointIndex = 0; PointIndex < NumPatrolPoints; ++PointIndex)
+	{
+		const float Angle = 2.f * PI * PointIndex / NumPatrolPoints;
+		const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * SpawnRadius * 0.5f;
+		if (ATargetPoint* Point = GetWorld()->SpawnActor<ATargetPoint>(ATargetPoint::StaticClass(), Location, FRotator::ZeroRotator))
+		{
+			PatrolPoints.Add(Point);
+		}
+	}
+
+	// One enemy and weapon per slot; dead ones go back to the pool before their replacement is taken.
+	// Enemies with a weapon component have no weapon actor to pool.
+	{
+		LLM_SCOPE_BYTAG(Eclipse_Enemies);
+		UCombatActorPoolSubsystem::Prewarm(this, EnemyClass, NumEnemies);
+	}
+	if (EnemyClass && EnemyClass->GetDefaultObject<AEnemy>()->WeaponClass && !EnemyClass->GetDefaultObject<AEnemy>()->UsesWeaponComponent())
+	{
+		LLM_SCOPE_BYTAG(Eclipse_Weapons);
+		UCombatActorPoolSubsystem::Prewarm(this, EnemyClass->GetDefaultObject<AEnemy>()->WeaponClass, NumEnemies);
+	}
+
+	// Stagger enemies across the cycle so patrol, chase, attack and death all happen every frame
+	const float CycleSeconds = FMath::Max(PatrolSeconds + ChaseSeconds, KINDA_SMALL_NUMBER);
+	EnemySlots.SetNum(NumEnemies);
+	for (int32 SlotIndex = 0; SlotIndex < NumEnemies; ++SlotIndex)
+	{
+		EnemySlots[SlotIndex].PhaseTime = CycleSeconds * SlotIndex / FMath::Max(NumEnemies, 1);
+		QueueSlotSpawn(SlotIndex);
+	}
+
+	UE_LOG(LogEclipse, Display, TEXT("CombatBenchmark: Started with %d enemies of %s (warmup %.1fs, duration %.1fs)"),
+		NumEnemies, *GetNameSafe(EnemyClass), WarmupSeconds, DurationSeconds);
+}
+
+void ACombatBenchmarkGameMode::QueueSlotSpawn(int32 SlotIndex)
+{
+	if (!EnemyClass || !PlayerCharacter)
+	{
+		return;
+	}
+
+	const FVector Center = PlayerCharacter->GetActorLocation();
+	const float Angle = 2.f * PI * SlotIndex / FMath::Max(NumEnemies, 1);
+	const FVector Direction(FMath::Cos(Angle), FMath::Sin(Angle), 0.f);
+
+	FEnemySpawnRequest Request;
+	Request.EnemyClass = EnemyClass;
+	Request.Transform = FTransform((-Direction).Rotation(), Center + Direction * SpawnRadius);
+	Request.PatrolTargets = PatrolPoints;
+	Request.PatrolTarget = PatrolPoints.Num() > 0 ? PatrolPoints[SlotIndex % PatrolPoints.Num()] : nullptr;
+	Request.bEnableCombatAI = true;
+	Request.Tag = SlotIndex;
+	QueueEnemySpawn(Request);
+
+	EnemySlots[SlotIndex].bSpawnQueued = true;
+}
+
+void ACombatBenchmarkGameMode::OnEnemySpawned(AEnemy* Enemy, int32 Tag)
+{
+	Super::OnEnemySpawned(Enemy, Tag);
+
+	if (EnemySlots.IsValidIndex(Tag))
+	{
+		EnemySlots[Tag].Enemy = Enemy;
+		EnemySlots[Tag].bSpawnQueued = false;
+		++Spawns;
+	}
+}
+
+void ACombatBenchmarkGameMode::OnEnemySpawnFailed(int32 Tag)
+{
+	Super::OnEnemySpawnFailed(Tag);
+
+	// The slot is queued again on its next tick
+	if (EnemySlots.IsValidIndex(Tag))
+	{
+		EnemySlots[Tag].bSpawnQueued = false;
+	}
+}
+
+void ACombatBenchmarkGameMode::EquipPlayerWeapon(AMyCharacter* Player)
+{
+	if (Player->EquippedWeapon)
+	{
+		return;
+	}
+
+	TSubclassOf<AWeapon> ClassToSpawn = PlayerWeaponClass ? PlayerWeaponClass : Player->WeaponClass;
+	if (!ClassToSpawn)
+	{
+		UE_LOG(LogEclipse, Warning, TEXT("CombatBenchmark: Player has no weapon class, only kicks will be exercised"));
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Eclipse_Weapons);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = Player;
+	SpawnParams.Instigator = Player;
+	if (AWeapon* Weapon = GetWorld()->SpawnActor<AWeapon>(ClassToSpawn, SpawnParams))
+	{
+		if (Player->GetMesh() && Player->GetMesh()->DoesSocketExist(FName("hand_r")))
+		{
+			Weapon->AttachToComponent(Player->GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, FName("hand_r"));
+		}
+		else
+		{
+			Weapon->AttachToActor(Player, FAttachmentTransformRules::KeepWorldTransform);
+		}
+		Player->SetWeaponOwner(Weapon);
+	}
+}
+
+void ACombatBenchmarkGameMode::TickEnemySlot(FEnemySlot& Slot, int32 SlotIndex, float DeltaSeconds)
+{
+	AEnemy* Enemy = Slot.Enemy.Get();
+	if (!Enemy)
+	{
+		if (!Slot.bSpawnQueued)
+		{
+			Slot = FEnemySlot();
+			QueueSlotSpawn(SlotIndex);
+		}
+		return;
+	}
+
+	Slot.PhaseTime += DeltaSeconds;
+
+	if (Slot.bKilled)
+	{
+		// Leave the corpse around for a moment so the death montage and HUD clear run, then replace it
+		if (Slot.PhaseTime >= CorpseSeconds)
+		{
+			UCombatActorPoolSubsystem::Release(Enemy);
+			Slot = FEnemySlot();
+			QueueSlotSpawn(SlotIndex);
+		}
+		return;
+	}
+
+	if (Slot.PhaseTime < PatrolSeconds)
+	{
+		return;
+	}
+
+	if (Slot.PhaseTime < PatrolSeconds + ChaseSeconds)
+	{
+		// Tick takes it from chasing to attacking once the player is in range
+		if (Enemy->EnemyState == EEnemyState::EES_Patrolling)
+		{
+			Enemy->SetEnemyState(EEnemyState::EES_Chasing);
+		}
+		return;
+	}
+
+	KillEnemy(Enemy);
+	Slot.bKilled = true;
+	Slot.PhaseTime = 0.f;
+}
+
+bool ACombatBenchmarkGameMode::IsPlayable() const
+{
+	if (!PlayerCharacter || GetNumPendingSpawns() > 0 || !UCombatAssetSubsystem::IsCharacterClassReady(this, PlayerCharacter->GetClass()))
+	{
+		return false;
+	}
+
+	for (const FEnemySlot& Slot : EnemySlots)
+	{
+		if (!Slot.Enemy.IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ACombatBenchmarkGameMode::KillEnemy(AEnemy* Enemy)
+{
+	UGameplayStatics::ApplyDamage(Enemy, TNumericLimits<float>::Max(), nullptr, nullptr, UDamageType::StaticClass());
+
+	// Same path a weapon hit takes: GetHit on a dead enemy runs Die()
+	Enemy->GetHit(Enemy->GetActorLocation());
+	++Kills;
+}
+
+void ACombatBenchmarkGameMode::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (bStarted && !bFinished && ElapsedSeconds >= WarmupSeconds && LastWorldTickStart > 0.0)
+	{
+		FrameTimesMs.Add(static_cast<float>((Now - LastWorldTickStart) * 1000.0));
+	}
+	LastWorldTickStart = Now;
+	WorldTickStart = Now;
+}
+
+void ACombatBenchmarkGameMode::OnEndFrame()
+{
+	// Game thread work from the start of the world tick to the end of the frame (excludes frame rate limiting)
+	if (bStarted && !bFinished && WorldTickStart > 0.0)
+	{
+		const float GameThreadMs = static_cast<float>((FPlatformTime::Seconds() - WorldTickStart) * 1000.0);
+		if (ElapsedSeconds >= WarmupSeconds)
+		{
+			GameThreadTimesMs.Add(GameThreadMs);
+		}
+		if (FirstAttackWindowEnd >= 0.f && ElapsedSeconds <= FirstAttackWindowEnd)
+		{
+			FirstAttackMaxFrameMs = FMath::Max(FirstAttackMaxFrameMs, GameThreadMs);
+		}
+	}
+	WorldTickStart = 0.0;
+
+	// Runs after the live counters published this frame, so the block must describe the world as it is now
+	if (bBudgetWindowOpen && !bFinished && FEclipseLiveCounters::IsRunning() && (GFrameCounter % LiveCounterCheckInterval) == 0)
+	{
+		CheckLiveCounters();
+	}
+}
+
+void ACombatBenchmarkGameMode::CheckLiveCounters()
+{
+	FEclipseLiveCounterBlock Block;
+	if (!FEclipseLiveCounters::ReadSnapshot(FPlatformProcess::GetCurrentProcessId(), Block))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatBenchmark: Could not read the live counter block"));
+		++LiveCounterMismatches;
+		return;
+	}
+
+	uint32 LiveEnemies = 0;
+	for (TActorIterator<AEnemy> It(GetWorld()); It; ++It)
+	{
+		LiveEnemies += It->bIsDead ? 0 : 1;
+	}
+
+	uint32 OpenWindows = 0;
+	for (TActorIterator<AWeapon> It(GetWorld()); It; ++It)
+	{
+		// Continuous hit windows keep the box disabled and sweep from Tick, so ask the weapon
+		OpenWindows += It->IsCollisionWindowOpen() ? 1 : 0;
+	}
+	for (TActorIterator<ABaseCharacter> It(GetWorld()); It; ++It)
+	{
+		const UWeaponComponent* WeaponComponent = It->GetWeaponComponent();
+		OpenWindows += WeaponComponent && WeaponComponent->IsCollisionWindowOpen() ? 1 : 0;
+	}
+
+	if (Block.Frame != GFrameCounter || Block.LiveEnemies != LiveEnemies || Block.ActiveWeaponWindows != OpenWindows)
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatBenchmark: Live counters frame %llu enemies %u windows %u, world frame %llu enemies %u windows %u"),
+			Block.Frame, Block.LiveEnemies, Block.ActiveWeaponWindows, GFrameCounter, LiveEnemies, OpenWindows);
+		++LiveCounterMismatches;
+	}
+}
+
+void ACombatBenchmarkGameMode::FinishBenchmark()
+{
+	bFinished = true;
+
+	int32 BudgetViolations = 0;
+#if ECLIPSE_WITH_PERF_BUDGETS
+	if (FEclipsePerfBudgets::IsEnabled())
+	{
+		BudgetViolations += FEclipsePerfBudgets::CheckBudgets();
+	}
+#endif
+#if ECLIPSE_WITH_ALLOC_TRACKING
+	if (FEclipseAllocTracking::IsInstalled())
+	{
+		BudgetViolations += FEclipseAllocTracking::CheckNoAllocations();
+	}
+#endif
+	BudgetViolations += LiveCounterMismatches;
+
+	WriteResults();
+
+	if (bExitWhenDone)
+	{
+		// Non-zero exit code so CI fails the run when a perf budget is exceeded or a hot path allocates
+		FPlatformMisc::RequestExitWithStatus(false, BudgetViolations > 0 ? 1 : 0);
+	}
+}
+
+float ACombatBenchmarkGameMode::Percentile(TArray<float>& SortedValues, float Percent)
+{
+	if (SortedValues.Num() == 0)
+	{
+		return 0.f;
+	}
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+	return SortedValues[Index];
+}
+
+void ACombatBenchmarkGameMode::WriteResults()
+{
+	FrameTimesMs.Sort();
+	GameThreadTimesMs.Sort();
+
+	FString FilePath = OutputFile.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("CombatBenchmark.csv"))
+		: OutputFile;
+
+	const FString WeaponModes = GetWeaponModeLabel();
+	const FString CollisionProfiles = FEclipseCollision::UseLegacyProfiles() ? TEXT("Legacy") : TEXT("Combat");
+	const uint64 OverlapCallbacks = bBudgetWindowOpen ? FEclipseCollision::GetOverlapCallbackCount() - OverlapCallbacksAtWindowStart : 0;
+	const double OverlapCallbacksPerFrame = FrameTimesMs.Num() > 0 ? static_cast<double>(OverlapCallbacks) / FrameTimesMs.Num() : 0.0;
+
+	const FString Header = TEXT("Timestamp,Map,EnemyClass,Enemies,Frames,FrameP50Ms,FrameP95Ms,FrameP99Ms,GameThreadP50Ms,GameThreadP95Ms,GameThreadP99Ms,Spawns,Kills,WeaponModes,CollisionProfiles,OverlapCallbacks,OverlapCallbacksPerFrame,ActorPool,EnemyWeapons,LaunchToPlayableMs,FirstAttackMaxFrameMs,CombatAssets");
+
+	// Results from before a column change are moved aside so rows always line up with the file's header
+	if (IFileManager::Get().FileExists(*FilePath))
+	{
+		TArray<FString> ExistingLines;
+		FFileHelper::LoadFileToStringArray(ExistingLines, *FilePath);
+		if (ExistingLines.Num() == 0 || ExistingLines[0].TrimEnd() != Header)
+		{
+			const FString RolledFilePath = FPaths::Combine(FPaths::GetPath(FilePath),
+				FString::Printf(TEXT("%s_%s.%s"), *FPaths::GetBaseFilename(FilePath), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *FPaths::GetExtension(FilePath)));
+			if (IFileManager::Get().Move(*RolledFilePath, *FilePath))
+			{
+				UE_LOG(LogEclipse, Display, TEXT("CombatBenchmark: %s has different columns, moved it to %s"), *FilePath, *RolledFilePath);
+			}
+			else
+			{
+				// Still keep this run, in a file of its own
+				UE_LOG(LogEclipse, Warning, TEXT("CombatBenchmark: %s has different columns and could not be moved aside, writing to %s"), *FilePath, *RolledFilePath);
+				FilePath = RolledFilePath;
+			}
+		}
+	}
+
+	FString Csv;
+	if (!IFileManager::Get().FileExists(*FilePath))
+	{
+		Csv += Header + TEXT("\n");
+	}
+
+	Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%s,%s,%llu,%.3f,%s,%s,%.1f,%.3f,%s\n"),
+		*FDateTime::UtcNow().ToIso8601(),
+		*UGameplayStatics::GetCurrentLevelName(this),
+		*GetNameSafe(EnemyClass),
+		NumEnemies,
+		FrameTimesMs.Num(),
+		Percentile(FrameTimesMs, 0.50f),
+		Percentile(FrameTimesMs, 0.95f),
+		Percentile(FrameTimesMs, 0.99f),
+		Percentile(GameThreadTimesMs, 0.50f),
+		Percentile(GameThreadTimesMs, 0.95f),
+		Percentile(GameThreadTimesMs, 0.99f),
+		Spawns,
+		Kills,
+		*WeaponModes,
+		*CollisionProfiles,
+		OverlapCallbacks,
+		OverlapCallbacksPerFrame,
+		UCombatActorPoolSubsystem::IsPoolingEnabled() ? TEXT("On") : TEXT("Off"),
+		EnemyClass && EnemyClass->GetDefaultObject<AEnemy>()->UsesWeaponComponent() ? TEXT("Component") : TEXT("Actor"),
+		LaunchToPlayableMs,
+		FirstAttackMaxFrameMs,
+		*UCombatAssetSubsystem::GetLoadingModeLabel());
+
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogEclipse, Display, TEXT("CombatBenchmark: %d frames, game thread p50/p95/p99 %.2f/%.2f/%.2f ms, %.2f overlap callbacks per frame (%s collision), written to %s"),
+			GameThreadTimesMs.Num(),
+			Percentile(GameThreadTimesMs, 0.50f),
+			Percentile(GameThreadTimesMs, 0.95f),
+			Percentile(GameThreadTimesMs, 0.99f),
+			OverlapCallbacksPerFrame,
+			*CollisionProfiles,
+			*FilePath);
+	}
+	else
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatBenchmark: Failed to write results to %s"), *FilePath);
+	}
+
+#if ECLIPSE_WITH_LATENCY_TRACKING
+	// Input-to-impact latency per attack section, next to the frame-time results
+	const FString LatencyFilePath = FPaths::Combine(FPaths::GetPath(FilePath), TEXT("CombatLatency.csv"));
+	FCombatLatencyTracker::Get().LogReport();
+	if (!FCombatLatencyTracker::Get().AppendCsv(LatencyFilePath, UGameplayStatics::GetCurrentLevelName(this) / WeaponModes))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatBenchmark: Failed to write latency results to %s"), *LatencyFilePath);
+	}
+#endif
+}
+
+FString ACombatBenchmarkGameMode::GetWeaponModeLabel() const
+{
+	// Hit and trace mode of the player's weapon (after console overrides), so A/B rows can be told apart
+	const AWeapon* Weapon = PlayerCharacter ? PlayerCharacter->EquippedWeapon : nullptr;
+	if (!Weapon)
+	{
+		return TEXT("None");
+	}
+
+	return FString::Printf(TEXT("%s+%s"),
+		*StaticEnum<EWeaponHitMode>()->GetNameStringByValue(static_cast<int64>(Weapon->GetEffectiveHitMode())),
+		*StaticEnum<EWeaponTraceMode>()->GetNameStringByValue(static_cast<int64>(Weapon->GetEffectiveTraceMode())));
+}
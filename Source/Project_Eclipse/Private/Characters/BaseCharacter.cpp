@@ -1,20 +1,68 @@
 #include "Characters/BaseCharacter.h"
 #include "Components/BoxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Weapons/Weapon.h"
 #include "Components/AttributeComponent.h"
+#include "Components/HitboxComponent.h"
+#include "Components/HurtboxComponent.h"
+#include "Components/WeaponComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Combat/EclipseCollision.h"
+#include "Animation/AttackTrajectoryAsset.h"
+#include "Combat/CombatAssetSet.h"
+#include "Combat/CombatAssetSubsystem.h"
+#include "Animation/AnimMontage.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundBase.h"
 #include "Engine/Engine.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+static int32 GEclipseCombatBakedTrajectories = 1;
+static FAutoConsoleVariableRef CVarEclipseCombatBakedTrajectories(
+	TEXT("Eclipse.Combat.BakedTrajectories"),
+	GEclipseCombatBakedTrajectories,
+	TEXT("Follow baked attack trajectories (UAttackTrajectoryAsset) for weapon sweeps instead of the animated sockets.\n")
+	TEXT("0: never, 1: when the pose is not evaluated (dedicated server, mesh not ticking its pose) (default), 2: always"));
+
+static int32 GEclipseWeaponComponentMode = -1;
+static FAutoConsoleVariableRef CVarEclipseWeaponComponentMode(
+	TEXT("Eclipse.Weapon.ComponentMode"),
+	GEclipseWeaponComponentMode,
+	TEXT("Overrides ABaseCharacter::bWeaponAsComponent for weapons equipped from now on.\n")
+	TEXT("-1: use the character's setting (default), 0: spawn an AWeapon actor, 1: weapon component on the character"));
 
 ABaseCharacter::ABaseCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
 	Attributes = CreateDefaultSubobject<UAttributeComponent>(TEXT("Attributes"));
+	Hitboxes = CreateDefaultSubobject<UHitboxComponent>(TEXT("Hitboxes"));
+
+	Hurtbox = CreateDefaultSubobject<UHurtboxComponent>(TEXT("Hurtbox"));
+
+	WeaponComponent = CreateDefaultSubobject<UWeaponComponent>(TEXT("WeaponComponent"));
+	WeaponComponent->SetupAttachment(GetMesh(), FName("hand_r"));
+
+	// Weapons find the capsule; the hurtbox narrows hits down to bones
+	FEclipseCollision::InitHurtbox(GetCapsuleComponent());
+	FEclipseCollision::InitCharacterMesh(GetMesh());
 }
 
 void ABaseCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	FEclipseCollision::ApplyLegacyCharacterMesh(GetMesh());
+	StartNewSwing();
+	LoadCombatAssets();
+
 	// Weapon spawning and attachment is now handled in Blueprint
 	// This allows for custom weapon setup per character blueprint
 }
@@ -33,6 +81,8 @@ void ABaseCharacter::AttackEnd()
 
 void ABaseCharacter::DirectionalHitReact(const FVector& ImpactPoint)
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseDirectionalHitReact);
+
 	const FVector Forward = GetActorForwardVector();
 	const FVector ImpactLowered(ImpactPoint.X, ImpactPoint.Y, GetActorLocation().Z);
 	const FVector ToHit = (ImpactLowered - GetActorLocation()).GetSafeNormal();
@@ -75,20 +125,20 @@ void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
 {
 	if (!GetMesh())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlayHitReactMontage: Mesh is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("PlayHitReactMontage: Mesh is null"));
 		return;
 	}
 
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (!AnimInstance)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlayHitReactMontage: AnimInstance is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("PlayHitReactMontage: AnimInstance is null"));
 		return;
 	}
 
 	if (!HitReactMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlayHitReactMontage: HitReactMontage is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("PlayHitReactMontage: HitReactMontage is null"));
 		return;
 	}
 
@@ -96,6 +146,7 @@ void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
 	AnimInstance->StopAllMontages(0.1f);
 	
 	// Play the hit react montage
+	INC_DWORD_STAT(STAT_EclipseMontagePlays);
 	AnimInstance->Montage_Play(HitReactMontage, 1.0f);
 	AnimInstance->Montage_JumpToSection(SectionName, HitReactMontage);
 	
@@ -104,7 +155,7 @@ void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
 	EndDelegate.BindUObject(this, &ABaseCharacter::OnHitReactMontageEnded);
 	AnimInstance->Montage_SetEndDelegate(EndDelegate, HitReactMontage);
 
-	UE_LOG(LogTemp, Warning, TEXT("PlayHitReactMontage: Successfully played montage section %s"), *SectionName.ToString());
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("PlayHitReactMontage: Successfully played montage section %s"), *SectionName.ToString());
 }
 
 void ABaseCharacter::OnHitReactMontageEnded(UAnimMontage* Montage, bool bInterrupted)
@@ -114,7 +165,7 @@ void ABaseCharacter::OnHitReactMontageEnded(UAnimMontage* Montage, bool bInterru
 	// Reset any state or flags after hit reaction is complete
 	if (Montage == HitReactMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("OnHitReactMontageEnded: Hit reaction montage ended"));
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("OnHitReactMontageEnded: Hit reaction montage ended"));
 	}
 }
 
@@ -125,75 +176,247 @@ void ABaseCharacter::Tick(float DeltaTime)
 
 void ABaseCharacter::GetHit(const FVector& ImpactPoint)
 {
+	ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::GetHit, nullptr, this, Attributes ? Attributes->GetHealthPercent() : 0.f, ImpactPoint);
+
 	if (!GetMesh() || !GetMesh()->GetAnimInstance())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GetHit: Mesh or AnimInstance is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("GetHit: Mesh or AnimInstance is null"));
 		return;
 	}
 
 	if (Attributes && Attributes->IsAlive())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GetHit: Playing hit reaction"));
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("GetHit: Playing hit reaction"));
 		DirectionalHitReact(ImpactPoint);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GetHit: Character is dead or has no attributes"));
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("GetHit: Character is dead or has no attributes"));
 	}
 }
 
+bool ABaseCharacter::UsesWeaponComponent() const
+{
+	return GEclipseWeaponComponentMode >= 0 ? GEclipseWeaponComponentMode != 0 : bWeaponAsComponent;
+}
+
 void ABaseCharacter::SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled)
 {
-	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	if (WeaponComponent && WeaponComponent->IsEquipped())
+	{
+		WeaponComponent->SetCollisionWindowEnabled(CollisionEnabled != ECollisionEnabled::NoCollision);
+	}
+	else if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
 	{
-		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(CollisionEnabled);
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter SetWeaponCollisionEnabled: %s"), 
+		EquippedWeapon->SetCollisionWindowEnabled(CollisionEnabled);
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("BaseCharacter SetWeaponCollisionEnabled: %s"), 
 			CollisionEnabled == ECollisionEnabled::QueryOnly ? TEXT("Enabled") : TEXT("Disabled"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter SetWeaponCollisionEnabled: No equipped weapon or weapon box"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("BaseCharacter SetWeaponCollisionEnabled: No equipped weapon or weapon box"));
 	}
 }
 
 void ABaseCharacter::EnableWeaponCollision()
 {
-	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	if (WeaponComponent && WeaponComponent->IsEquipped())
 	{
-		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		ClearWeaponHitActors();
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter EnableWeaponCollision: Weapon collision enabled"));
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("WEAPON COLLISION ENABLED"));
+		WeaponComponent->SetCollisionWindowEnabled(true);
+		StartNewSwing();
+	}
+	else if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	{
+		EquippedWeapon->SetCollisionWindowEnabled(ECollisionEnabled::QueryOnly);
+		StartNewSwing();
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("BaseCharacter EnableWeaponCollision: Weapon collision enabled"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Green, TEXT("WEAPON COLLISION ENABLED"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter EnableWeaponCollision: No equipped weapon or weapon box"));
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("NO WEAPON OR WEAPON BOX"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("BaseCharacter EnableWeaponCollision: No equipped weapon or weapon box"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Red, TEXT("NO WEAPON OR WEAPON BOX"));
 	}
 }
 
 void ABaseCharacter::DisableWeaponCollision()
 {
-	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	if (WeaponComponent && WeaponComponent->IsEquipped())
 	{
-		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter DisableWeaponCollision: Weapon collision disabled"));
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Orange, TEXT("WEAPON COLLISION DISABLED"));
+		WeaponComponent->SetCollisionWindowEnabled(false);
+	}
+	else if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	{
+		EquippedWeapon->SetCollisionWindowEnabled(ECollisionEnabled::NoCollision);
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("BaseCharacter DisableWeaponCollision: Weapon collision disabled"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Orange, TEXT("WEAPON COLLISION DISABLED"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("BaseCharacter DisableWeaponCollision: No equipped weapon or weapon box"));
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("NO WEAPON OR WEAPON BOX"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("BaseCharacter DisableWeaponCollision: No equipped weapon or weapon box"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Red, TEXT("NO WEAPON OR WEAPON BOX"));
+	}
+}
+
+void ABaseCharacter::StartNewSwing()
+{
+	SwingId = FCombatHitLedger::NewSwingId();
+}
+
+void ABaseCharacter::ResetCombatState()
+{
+	if (Attributes)
+	{
+		Attributes->ResetHealth();
+	}
+
+	HitLedger.Reset();
+	StartNewSwing();
+	ActiveAttackSection = NAME_None;
+	if (WeaponComponent)
+	{
+		WeaponComponent->SetCollisionWindowEnabled(false);
+	}
+	if (Hitboxes)
+	{
+		Hitboxes->DeactivateAllShapes();
+	}
+
+	if (USkeletalMeshComponent* CharacterMesh = GetMesh())
+	{
+		// Death freezes the pose
+		CharacterMesh->bPauseAnims = false;
+		if (UAnimInstance* AnimInstance = CharacterMesh->GetAnimInstance())
+		{
+			AnimInstance->StopAllMontages(0.f);
+		}
+
+		FEclipseCollision::InitCharacterMesh(CharacterMesh);
+		FEclipseCollision::ApplyLegacyCharacterMesh(CharacterMesh);
 	}
 }
 
-void ABaseCharacter::ClearWeaponHitActors()
+void ABaseCharacter::LoadCombatAssets()
 {
-	if (EquippedWeapon)
+	if (CombatAssets)
+	{
+		UCombatAssetSubsystem::RequestLoad(this, CombatAssets, FSimpleDelegate::CreateWeakLambda(this, [this]()
+		{
+			ApplyCombatAssets();
+		}));
+	}
+}
+
+void ABaseCharacter::ApplyCombatAssets()
+{
+	if (!CombatAssets)
+	{
+		return;
+	}
+
+	// Entries the set leaves empty, or that failed to load, keep the character's own
+	if (UAnimMontage* Montage = CombatAssets->AttackMontage.Get())
+	{
+		AttackMontage = Montage;
+	}
+	if (UAnimMontage* Montage = CombatAssets->HitReactMontage.Get())
 	{
-		EquippedWeapon->ClearHitActors();
+		HitReactMontage = Montage;
 	}
-	HitActors.Empty();
+	if (USoundBase* Sound = CombatAssets->HitSound.Get())
+	{
+		HitSound = Sound;
+	}
+	if (UFXSystemAsset* Particles = CombatAssets->HitParticles.Get())
+	{
+		HitParticles = Particles;
+	}
+	if (UClass* LoadedWeaponClass = CombatAssets->WeaponClass.Get())
+	{
+		WeaponClass = LoadedWeaponClass;
+	}
+}
+
+#if WITH_EDITOR
+EDataValidationResult ABaseCharacter::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	bool bValid = ValidateReplacedByCombatAssets(Context, AttackMontage, TEXT("AttackMontage"));
+	bValid &= ValidateReplacedByCombatAssets(Context, HitReactMontage, TEXT("HitReactMontage"));
+	bValid &= ValidateReplacedByCombatAssets(Context, HitSound, TEXT("HitSound"));
+	bValid &= ValidateReplacedByCombatAssets(Context, HitParticles, TEXT("HitParticles"));
+	bValid &= ValidateReplacedByCombatAssets(Context, WeaponClass.Get(), TEXT("WeaponClass"));
+	if (!bValid)
+	{
+		Result = EDataValidationResult::Invalid;
+	}
+	return Result;
+}
+
+bool ABaseCharacter::ValidateReplacedByCombatAssets(FDataValidationContext& Context, const UObject* HardReference, const TCHAR* PropertyName) const
+{
+	if (!CombatAssets || !HardReference)
+	{
+		return true;
+	}
+
+	Context.AddError(FText::FromString(FString::Printf(TEXT("%s is set along with CombatAssets (%s); clear it so %s isn't loaded with the map"),
+		PropertyName, *CombatAssets->GetName(), *HardReference->GetName())));
+	return false;
+}
+#endif
+
+void ABaseCharacter::BeginAttackTrajectory(FName SectionName)
+{
+	ActiveAttackSection = SectionName;
+	ActiveAttackStartTime = GetWorld()->GetTimeSeconds();
+}
+
+bool ABaseCharacter::GetBakedAttackSegment(FName TrackName, FVector& OutStart, FVector& OutEnd) const
+{
+	if (!AttackTrajectories || ActiveAttackSection.IsNone() || GEclipseCombatBakedTrajectories == 0)
+	{
+		return false;
+	}
+
+	const USkeletalMeshComponent* MeshComponent = GetMesh();
+	if (!MeshComponent)
+	{
+		return false;
+	}
+
+	if (GEclipseCombatBakedTrajectories == 1 && !IsNetMode(NM_DedicatedServer) && MeshComponent->ShouldTickPose())
+	{
+		return false;
+	}
+
+	const FAttackTrajectorySection* Section = AttackTrajectories->FindSection(ActiveAttackSection);
+	const float Time = GetWorld()->GetTimeSeconds() - ActiveAttackStartTime;
+	if (!Section || !AttackTrajectories->SampleSegment(*Section, AttackTrajectories->FindTrack(TrackName), Time, OutStart, OutEnd))
+	{
+		return false;
+	}
+
+	// Baked in mesh component space, which only depends on the actor root and the mesh offset
+	const FTransform& MeshTransform = MeshComponent->GetComponentTransform();
+	OutStart = MeshTransform.TransformPosition(OutStart);
+	OutEnd = MeshTransform.TransformPosition(OutEnd);
+	return true;
+}
+
+bool ABaseCharacter::HasAlreadyHit(AActor* Other) const
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(Other);
+	const FCombatHitLedger* Ledger = HitInterface ? HitInterface->GetHitLedger() : nullptr;
+	return Ledger && Ledger->HasHit(GetUniqueID(), SwingId);
+}
+
+bool ABaseCharacter::TryRecordHit(AActor* Other)
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(Other);
+	FCombatHitLedger* Ledger = HitInterface ? HitInterface->GetHitLedger() : nullptr;
+	return !Ledger || Ledger->TryRecordHit(GetUniqueID(), SwingId);
 }
 
 
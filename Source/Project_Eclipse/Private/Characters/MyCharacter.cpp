@@ -20,12 +20,27 @@
 #include "Components/InputComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "InputAction.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Combat/CombatResolutionSubsystem.h"
+#include "Combat/CombatEffectsSubsystem.h"
+#include "Components/HitboxComponent.h"
+#include "Replay/CombatReplaySubsystem.h"
 
 
 
 
+const FName AMyCharacter::KickLeftShapeName(TEXT("KickL"));
+const FName AMyCharacter::KickRightShapeName(TEXT("KickR"));
+
 AMyCharacter::AMyCharacter()
 {
     PrimaryActorTick.bCanEverTick = true;
@@ -52,18 +67,20 @@ AMyCharacter::AMyCharacter()
 
 
 
-    // Create kick box components for both legs
-    KickBoxLeft = CreateDefaultSubobject<UBoxComponent>(TEXT("Kick Box Left"));
-    KickBoxLeft->SetupAttachment(GetMesh(), FName("foot_l"));
-    KickBoxLeft->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    KickBoxLeft->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-    KickBoxLeft->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+    // Kick shapes for both legs, active from EnableKickCollision until DisableKickCollision
+    FHitboxShape KickLeft;
+    KickLeft.Name = KickLeftShapeName;
+    KickLeft.Socket = FName("foot_l");
+    KickLeft.Radius = 20.f;
+    KickLeft.Damage = 15.f;
+    KickLeft.TrajectoryTrack = FName("FootL");
+    Hitboxes->AddOrUpdateShape(KickLeft);
 
-    KickBoxRight = CreateDefaultSubobject<UBoxComponent>(TEXT("Kick Box Right"));
-    KickBoxRight->SetupAttachment(GetMesh(), FName("foot_r"));
-    KickBoxRight->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    KickBoxRight->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-    KickBoxRight->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+    FHitboxShape KickRight = KickLeft;
+    KickRight.Name = KickRightShapeName;
+    KickRight.Socket = FName("foot_r");
+    KickRight.TrajectoryTrack = FName("FootR");
+    Hitboxes->AddOrUpdateShape(KickRight);
 
     // Montages should be set in Blueprint editor, not in constructor
 }
@@ -100,9 +117,6 @@ void AMyCharacter::BeginPlay()
 	
 
 	
-	KickBoxLeft->OnComponentBeginOverlap.AddDynamic(this, &AMyCharacter::OnKickBoxOverlap);
-	KickBoxRight->OnComponentBeginOverlap.AddDynamic(this, &AMyCharacter::OnKickBoxOverlap);
-
 	Tags.Add(FName("MyCharacter"));
 
 }
@@ -194,6 +208,16 @@ void AMyCharacter::PlayAttackMontage()
     PlayAttackMontageSection(FName("Attack1"));
 }
 
+void AMyCharacter::SetActionState(EActionState NewState)
+{
+    if (ActionState != NewState)
+    {
+        ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::ActionStateChange, this, nullptr, 0.f, GetActorLocation(),
+            static_cast<uint8>(ActionState), static_cast<uint8>(NewState));
+    }
+    ActionState = NewState;
+}
+
 bool AMyCharacter::PlayAttackMontageSection(FName SectionName)
 {
     if (ActionState != EActionState::EAS_Unoccupied)
@@ -207,7 +231,8 @@ bool AMyCharacter::PlayAttackMontageSection(FName SectionName)
         return false;
     }
 
-    ActionState = EActionState::EAS_Attacking;
+    SetActionState(EActionState::EAS_Attacking);
+    ECLIPSE_LATENCY_BEGIN_ATTACK(this, SectionName);
 
     if (GetCharacterMovement())
     {
@@ -215,13 +240,15 @@ bool AMyCharacter::PlayAttackMontageSection(FName SectionName)
         GetCharacterMovement()->bUseControllerDesiredRotation = true;
     }
 
-    HitActors.Empty();
-    ClearWeaponHitActors();
+    StartNewSwing();
     DisableWeaponCollision();
     DisableKickCollision();
 
+    INC_DWORD_STAT(STAT_EclipseMontagePlays);
     AnimInstance->Montage_Play(AttackMontage, 1.0f);
     AnimInstance->Montage_JumpToSection(SectionName, AttackMontage);
+    BeginAttackTrajectory(SectionName);
+    ECLIPSE_LATENCY_MARK(this, MontageStart);
 
     FOnMontageEnded EndDelegate;
     EndDelegate.BindUObject(this, &AMyCharacter::OnMontageEnded);
@@ -231,130 +258,67 @@ bool AMyCharacter::PlayAttackMontageSection(FName SectionName)
     return true;
 }
 
+void AMyCharacter::HandleAttackInput(FName SectionName)
+{
+    // Before the state and montage checks, so Input -> MontageStart includes them; a rejected input records nothing
+    ECLIPSE_LATENCY_INPUT(this);
+    if (!PlayAttackMontageSection(SectionName))
+    {
+        ECLIPSE_LATENCY_CANCEL_INPUT(this);
+    }
+}
+
 void AMyCharacter::Attack1()
 {
-    PlayAttackMontageSection(FName("Attack1"));
+    HandleAttackInput(FName("Attack1"));
 }
 
 void AMyCharacter::Attack2()
 {
-    PlayAttackMontageSection(FName("Attack2"));
+    HandleAttackInput(FName("Attack2"));
 }
 
 void AMyCharacter::Attack3()
 {
-    PlayAttackMontageSection(FName("Attack3"));
+    HandleAttackInput(FName("Attack3"));
 }
 
 
 
 void AMyCharacter::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
+	ECLIPSE_LATENCY_END_ATTACK(this);
+
 	if (!bInterrupted)
 	{
 		AttackEnd();
 	}
 }
 
-void AMyCharacter::OnKickBoxOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	// Check if we have a valid actor and it's not ourselves
-	if (!OtherActor || OtherActor == this)
-	{
-		return;
-	}
-
-	// Check if we're currently attacking
-	if (ActionState != EActionState::EAS_Attacking)
-	{
-		return;
-	}
-
-	// Check if the other actor is part of our character (prevent self-damage)
-	if (OtherActor == GetOwner() || OtherActor->IsAttachedTo(this))
-	{
-		return;
-	}
-
-	// Check if we've already hit this actor in this attack
-	if (HitActors.Contains(OtherActor))
-	{
-		return;
-	}
-
-	// Check if the other actor is alive (implements hit interface)
-	IHitInterface* HitInterface = Cast<IHitInterface>(OtherActor);
-	if (HitInterface)
-	{
-		// Add this actor to our hit list to prevent multiple hits
-		HitActors.Add(OtherActor);
-		
-		// Apply damage to the hit actor
-		UGameplayStatics::ApplyDamage(
-			OtherActor,
-			15.f, // Kick damage
-			GetController(),
-			this,
-			UDamageType::StaticClass()
-		);
-
-		// Trigger hit reaction
-		HitInterface->GetHit(SweepResult.ImpactPoint);
-
-		// Set the hit enemy as the targeted enemy for the HUD
-		if (AEnemy* HitEnemy = Cast<AEnemy>(OtherActor))
-		{
-			if (APlayerController* PlayerController = Cast<APlayerController>(GetController()))
-			{
-				if (AMainHUD* MainHUD = Cast<AMainHUD>(PlayerController->GetHUD()))
-				{
-					MainHUD->SetTargetedEnemy(HitEnemy);
-				}
-			}
-		}
-		
-		UE_LOG(LogTemp, Warning, TEXT("OnKickBoxOverlap: Hit %s with kick damage"), *OtherActor->GetName());
-	}
-}
-
 void AMyCharacter::EnableKickCollision()
 {
     // Add a small delay to prevent rapid-fire hits
-    FTimerHandle TimerHandle;
-    GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this]()
+    GetWorld()->GetTimerManager().SetTimer(KickEnableTimer, FTimerDelegate::CreateWeakLambda(this, [this]()
     {
-        if (KickBoxLeft)
-        {
-            KickBoxLeft->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-        }
-        if (KickBoxRight)
-        {
-            KickBoxRight->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-        }
-        UE_LOG(LogTemp, Warning, TEXT("EnableKickCollision: Kick collision enabled after delay"));
-    }, 0.1f, false); // 0.1 second delay
+        Hitboxes->SetShapeActive(KickLeftShapeName, true);
+        Hitboxes->SetShapeActive(KickRightShapeName, true);
+        ECLIPSE_LATENCY_MARK(this, KickWindow);
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("EnableKickCollision: Kick collision enabled after delay"));
+    }), 0.1f, false); // 0.1 second delay
 }
 
 void AMyCharacter::DisableKickCollision()
 {
-    if (KickBoxLeft)
-    {
-        KickBoxLeft->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    }
-    if (KickBoxRight)
-    {
-        KickBoxRight->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    }
+    GetWorld()->GetTimerManager().ClearTimer(KickEnableTimer);
+    Hitboxes->SetShapeActive(KickLeftShapeName, false);
+    Hitboxes->SetShapeActive(KickRightShapeName, false);
 }
 
 void AMyCharacter::AttackEnd()
 {
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 	DisableKickCollision();
 	
-	// Clear the hit actors list for the next attack
-	HitActors.Empty();
-	
 	
 	// Reset attack count if we've completed the full combo
 	if (AttackCount >= 4)
@@ -383,6 +347,7 @@ float AMyCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEve
     if (Attributes && Attributes->IsAlive())
     {
         Attributes->ReceiveDamage(DamageAmount);
+        UCombatReplaySubsystem::NotifyDamageTaken(this, DamageAmount);
         
         // Update the health bar UI
         if (Character_Overlay)
@@ -420,19 +385,19 @@ void AMyCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 
 	if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))
 	{
-        EnhancedInputComponent->BindAction(MovementAction, ETriggerEvent::Triggered, this, &AMyCharacter::Move);
-        EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AMyCharacter::Jump);
-        EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AMyCharacter::Look);
+        EnhancedInputComponent->BindAction(MovementAction, ETriggerEvent::Triggered, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Move);
+        EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Jump);
+        EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Look);
 
         // Bind specific attack inputs to fixed sections
-        EnhancedInputComponent->BindAction(AttackAction1, ETriggerEvent::Triggered, this, &AMyCharacter::Attack1);
-        EnhancedInputComponent->BindAction(AttackAction2, ETriggerEvent::Triggered, this, &AMyCharacter::Attack2);
-        EnhancedInputComponent->BindAction(AttackAction3, ETriggerEvent::Triggered, this, &AMyCharacter::Attack3);
+        EnhancedInputComponent->BindAction(AttackAction1, ETriggerEvent::Triggered, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Attack1);
+        EnhancedInputComponent->BindAction(AttackAction2, ETriggerEvent::Triggered, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Attack2);
+        EnhancedInputComponent->BindAction(AttackAction3, ETriggerEvent::Triggered, this, &AMyCharacter::HandleInputAction, ECombatInputAction::Attack3);
 
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetupPlayerInputComponent: Failed to cast to EnhancedInputComponent"));
+		UE_LOG(LogEclipseCombat, Error, TEXT("SetupPlayerInputComponent: Failed to cast to EnhancedInputComponent"));
 	}
 }
 
@@ -440,19 +405,14 @@ void AMyCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompone
 void AMyCharacter::EnableWeaponCollision()
 {
 	Super::EnableWeaponCollision();
-	UE_LOG(LogTemp, Warning, TEXT("MyCharacter EnableWeaponCollision: Called"));
+	ECLIPSE_LATENCY_MARK(this, WeaponWindow);
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("MyCharacter EnableWeaponCollision: Called"));
 }
 
 void AMyCharacter::DisableWeaponCollision()
 {
 	Super::DisableWeaponCollision();
-	UE_LOG(LogTemp, Warning, TEXT("MyCharacter DisableWeaponCollision: Called"));
-}
-
-void AMyCharacter::ClearWeaponHitActors()
-{
-	Super::ClearWeaponHitActors();
-	UE_LOG(LogTemp, Warning, TEXT("MyCharacter ClearWeaponHitActors: Called"));
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("MyCharacter DisableWeaponCollision: Called"));
 }
 
 void AMyCharacter::SetWeaponOwner(AWeapon* Weapon)
@@ -462,38 +422,39 @@ void AMyCharacter::SetWeaponOwner(AWeapon* Weapon)
 		Weapon->SetOwner(this);
 		Weapon->SetInstigator(this);
 		EquippedWeapon = Weapon;
+		AWeapon::NotifyAttachmentsChanged(this);
 		
 		// Initially disable weapon collision
 		DisableWeaponCollision();
 		
-		UE_LOG(LogTemp, Warning, TEXT("MyCharacter SetWeaponOwner: Weapon owner set to %s"), *GetName());
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, 
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("MyCharacter SetWeaponOwner: Weapon owner set to %s"), *GetName());
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Green, 
 			FString::Printf(TEXT("Player Weapon Owner Set: %s"), *GetName()));
 		
 		// DEBUG: Test if weapon collision can be enabled manually
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Blue, 
+		ECLIPSE_SCREEN_MESSAGE(5.0f, FColor::Blue, 
 			TEXT("DEBUG: Try pressing 'T' to manually enable weapon collision"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MyCharacter SetWeaponOwner: Weapon is null"));
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("MyCharacter SetWeaponOwner: Weapon is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("MyCharacter SetWeaponOwner: Weapon is null"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Red, TEXT("MyCharacter SetWeaponOwner: Weapon is null"));
 	}
 }
 
 void AMyCharacter::TestEnableWeaponCollision()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Purple, TEXT("MANUAL TEST: Enabling weapon collision"));
+	ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Purple, TEXT("MANUAL TEST: Enabling weapon collision"));
 	EnableWeaponCollision();
 	
 	if (EquippedWeapon)
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Purple, 
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Purple, 
 			FString::Printf(TEXT("MANUAL TEST: Weapon owner is %s"), EquippedWeapon->GetOwner() ? *EquippedWeapon->GetOwner()->GetName() : TEXT("NULL")));
 	}
 	else
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, TEXT("MANUAL TEST: No equipped weapon"));
+		ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Red, TEXT("MANUAL TEST: No equipped weapon"));
 	}
 }
 
@@ -516,6 +477,48 @@ void AMyCharacter::InitializeCharacterOverlay()
 	}
 }
 
+void AMyCharacter::HandleInputAction(const FInputActionInstance& Instance, ECombatInputAction Action)
+{
+	const FVector2D Value = Instance.GetValue().Get<FVector2D>();
+
+	if (UCombatReplaySubsystem* Replay = GetWorld()->GetSubsystem<UCombatReplaySubsystem>())
+	{
+		// Live input would make the replayed fight diverge
+		if (Replay->IsReplaying())
+		{
+			return;
+		}
+		Replay->RecordInput(Action, Value);
+	}
+
+	ApplyInput(Action, Value);
+}
+
+void AMyCharacter::ApplyInput(ECombatInputAction Action, const FVector2D& Value)
+{
+	switch (Action)
+	{
+	case ECombatInputAction::Move:
+		Move(FInputActionValue(Value));
+		break;
+	case ECombatInputAction::Look:
+		Look(FInputActionValue(Value));
+		break;
+	case ECombatInputAction::Jump:
+		Jump();
+		break;
+	case ECombatInputAction::Attack1:
+		Attack1();
+		break;
+	case ECombatInputAction::Attack2:
+		Attack2();
+		break;
+	case ECombatInputAction::Attack3:
+		Attack3();
+		break;
+	}
+}
+
 void AMyCharacter::Move(const FInputActionValue& Value)
 {
 	const FVector2D MovementVector = Value.Get<FVector2D>();
@@ -556,9 +559,11 @@ void AMyCharacter::ControlAnimationRootMotion()
 
 void AMyCharacter::GetHit(const FVector& ImpactPoint)
 {
+    ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::GetHit, nullptr, this, Attributes ? Attributes->GetHealthPercent() : 0.f, ImpactPoint);
+
     if (!GetMesh() || !GetMesh()->GetAnimInstance())
     {
-        UE_LOG(LogTemp, Warning, TEXT("GetHit: Mesh or AnimInstance is null"));
+        ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("GetHit: Mesh or AnimInstance is null"));
         return;
     }
 
@@ -569,7 +574,7 @@ void AMyCharacter::GetHit(const FVector& ImpactPoint)
 
         // Play hit reaction
         DirectionalHitReact(ImpactPoint);
-        UE_LOG(LogTemp, Warning, TEXT("GetHit: Playing hit reaction"));
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("GetHit: Playing hit reaction"));
 
         // Disable weapon collision during hit reaction
         DisableWeaponCollision();
@@ -577,18 +582,7 @@ void AMyCharacter::GetHit(const FVector& ImpactPoint)
     }
 
     // Play hit effects
-    if (HitSound)
-    {
-        UGameplayStatics::PlaySoundAtLocation(this, HitSound, ImpactPoint);
-    }
-    if (HitParticles && GetWorld())
-    {
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(),
-            HitParticles,
-            ImpactPoint
-        );
-    }
+    UCombatEffectsSubsystem::PlayHitEffects(this, HitParticles, HitSound, ImpactPoint);
 }
 
 void AMyCharacter::OnHitReactMontageEnded(UAnimMontage* Montage, bool bInterrupted)
@@ -597,8 +591,8 @@ void AMyCharacter::OnHitReactMontageEnded(UAnimMontage* Montage, bool bInterrupt
     
     if (Montage == HitReactMontage)
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnHitReactMontageEnded: Hit reaction montage ended"));
-        ActionState = EActionState::EAS_Unoccupied;
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("OnHitReactMontageEnded: Hit reaction montage ended"));
+        SetActionState(EActionState::EAS_Unoccupied);
         
         // Re-enable movement rotation
         if (GetCharacterMovement())
@@ -0,0 +1,288 @@
+#include "Combat/CombatActorPoolSubsystem.h"
+#include "Interfaces/PooledActor.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GEclipsePoolEnabled = 1;
+static FAutoConsoleVariableRef CVarEclipsePoolEnabled(
+	TEXT("Eclipse.Pool.Enabled"),
+	GEclipsePoolEnabled,
+	TEXT("Reuse enemies and weapons through UCombatActorPoolSubsystem.\n")
+	TEXT("0: spawn and destroy them every time, 1: park released actors and hand them out again (default)"));
+
+UCombatActorPoolSubsystem* UCombatActorPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UCombatActorPoolSubsystem>() : nullptr;
+}
+
+bool UCombatActorPoolSubsystem::IsPoolingEnabled()
+{
+	return GEclipsePoolEnabled != 0;
+}
+
+bool UCombatActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatActorPoolSubsystem::Deinitialize()
+{
+	// The world is going away with every actor in it
+	Pools.Empty();
+	Records.Empty();
+	FEclipseLiveCounters::SetPoolOccupancy(0, 0);
+
+	Super::Deinitialize();
+}
+
+void UCombatActorPoolSubsystem::Prewarm(const UObject* WorldContextObject, TSubclassOf<AActor> Class, int32 Count)
+{
+	UCombatActorPoolSubsystem* Pool = Get(WorldContextObject);
+	if (!Pool || !Class || !IsPoolingEnabled() || !Class->ImplementsInterface(UPooledActor::StaticClass()))
+	{
+		return;
+	}
+
+	const int32 NumToSpawn = Count - Pool->Pools.FindOrAdd(Class).Free.Num();
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		AActor* Actor = Pool->SpawnPooled(Class, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Actor)
+		{
+			break;
+		}
+
+		Actor->SetActorHiddenInGame(true);
+		Actor->FinishSpawning(FTransform::Identity);
+		CastChecked<IPooledActor>(Actor)->OnReleasedToPool();
+
+		FPooledActorRecord& Record = Pool->Records.FindChecked(Actor);
+		Pool->Park(Actor, Record);
+		Record.bWasHidden = false;	// hidden only so the spawn never renders
+		Pool->Pools.FindChecked(Class).Free.Add(Actor);
+	}
+
+	ECLIPSE_LOG(LogEclipse, Verbose, TEXT("Pool: %d free %s"), Pool->Pools.FindChecked(Class).Free.Num(), *GetNameSafe(Class));
+	Pool->PublishOccupancy();
+}
+
+AActor* UCombatActorPoolSubsystem::AcquireDeferredActor(const UObject* WorldContextObject, TSubclassOf<AActor> Class, const FTransform& Transform,
+	AActor* Owner, APawn* Instigator)
+{
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipsePoolAcquire);
+
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || !Class)
+	{
+		return nullptr;
+	}
+
+	UCombatActorPoolSubsystem* Pool = World->GetSubsystem<UCombatActorPoolSubsystem>();
+	if (!Pool || !IsPoolingEnabled() || !Class->ImplementsInterface(UPooledActor::StaticClass()))
+	{
+		return World->SpawnActorDeferred<AActor>(Class, Transform, Owner, Instigator, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	}
+
+	return Pool->AcquireFromPool(Class, Transform, Owner, Instigator);
+}
+
+AActor* UCombatActorPoolSubsystem::AcquireFromPool(UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	FCombatActorPool& ClassPool = Pools.FindOrAdd(Class);
+
+	AActor* Actor = nullptr;
+	while (!Actor && ClassPool.Free.Num() > 0)
+	{
+		AActor* Candidate = ClassPool.Free.Pop(EAllowShrinking::No);
+		Actor = IsValid(Candidate) ? Candidate : nullptr;
+	}
+
+	if (Actor)
+	{
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetOwner(Owner);
+		Actor->SetInstigator(Instigator);
+	}
+	else
+	{
+		Actor = SpawnPooled(Class, Transform, Owner, Instigator, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+	}
+
+	Records.FindChecked(Actor).bInUse = true;
+	++ClassPool.NumInUse;
+	PublishOccupancy();
+	return Actor;
+}
+
+void UCombatActorPoolSubsystem::FinishAcquire(AActor* Actor, const FTransform& Transform)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	if (!Actor->IsActorInitialized())
+	{
+		Actor->FinishSpawning(Transform);
+	}
+
+	UCombatActorPoolSubsystem* Pool = Get(Actor);
+	FPooledActorRecord* Record = Pool ? Pool->Records.Find(Actor) : nullptr;
+	if (!Record)
+	{
+		return;
+	}
+
+	if (Record->bParked)
+	{
+		Pool->Unpark(Actor, *Record);
+	}
+
+	// May acquire other pooled actors (an enemy's weapon), so Record isn't used after this
+	CastChecked<IPooledActor>(Actor)->OnAcquiredFromPool();
+}
+
+void UCombatActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipsePoolRelease);
+
+	UCombatActorPoolSubsystem* Pool = Get(Actor);
+	const FPooledActorRecord* Record = Pool ? Pool->Records.Find(Actor) : nullptr;
+	if (!Record)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	if (!Record->bInUse)
+	{
+		return;
+	}
+
+	// May release other pooled actors (an enemy's weapon), so the record is looked up again afterwards
+	CastChecked<IPooledActor>(Actor)->OnReleasedToPool();
+	Pool->ReturnToPool(Actor);
+}
+
+AActor* UCombatActorPoolSubsystem::SpawnPooled(UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator,
+	ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	INC_DWORD_STAT(STAT_EclipsePoolSpawns);
+
+	AActor* Actor = GetWorld()->SpawnActorDeferred<AActor>(Class, Transform, Owner, Instigator, CollisionHandling);
+	if (!Actor)
+	{
+		UE_LOG(LogEclipse, Error, TEXT("Pool: Failed to spawn %s"), *GetNameSafe(Class));
+		return nullptr;
+	}
+
+	Records.Add(Actor);
+	Actor->OnDestroyed.AddDynamic(this, &UCombatActorPoolSubsystem::OnPooledActorDestroyed);
+	CastChecked<IPooledActor>(Actor)->OnPoolSpawned();
+	return Actor;
+}
+
+void UCombatActorPoolSubsystem::ReturnToPool(AActor* Actor)
+{
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetOwner(nullptr);
+	Actor->SetInstigator(nullptr);
+
+	FPooledActorRecord& Record = Records.FindChecked(Actor);
+	Park(Actor, Record);
+	Record.bInUse = false;
+
+	FCombatActorPool& ClassPool = Pools.FindChecked(Actor->GetClass());
+	--ClassPool.NumInUse;
+	ClassPool.Free.Add(Actor);
+	PublishOccupancy();
+}
+
+void UCombatActorPoolSubsystem::Park(AActor* Actor, FPooledActorRecord& Record)
+{
+	Record.bWasHidden = Actor->IsHidden();
+	Record.bCollisionWasEnabled = Actor->GetActorEnableCollision();
+	Record.bActorTickWasEnabled = Actor->IsActorTickEnabled();
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	Record.PausedComponents.Reset();
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component->IsComponentTickEnabled())
+		{
+			Component->SetComponentTickEnabled(false);
+			Record.PausedComponents.Add(Component);
+		}
+	}
+
+	Record.bParked = true;
+}
+
+void UCombatActorPoolSubsystem::Unpark(AActor* Actor, FPooledActorRecord& Record)
+{
+	Actor->SetActorHiddenInGame(Record.bWasHidden);
+	Actor->SetActorEnableCollision(Record.bCollisionWasEnabled);
+	Actor->SetActorTickEnabled(Record.bActorTickWasEnabled);
+
+	for (UActorComponent* Component : Record.PausedComponents)
+	{
+		if (Component)
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+	Record.PausedComponents.Reset();
+
+	Record.bParked = false;
+}
+
+void UCombatActorPoolSubsystem::OnPooledActorDestroyed(AActor* DestroyedActor)
+{
+	FPooledActorRecord Record;
+	if (!Records.RemoveAndCopyValue(DestroyedActor, Record))
+	{
+		return;
+	}
+
+	if (FCombatActorPool* ClassPool = Pools.Find(DestroyedActor->GetClass()))
+	{
+		if (Record.bInUse)
+		{
+			--ClassPool->NumInUse;
+		}
+		else
+		{
+			ClassPool->Free.RemoveSingleSwap(DestroyedActor);
+		}
+	}
+	PublishOccupancy();
+}
+
+void UCombatActorPoolSubsystem::PublishOccupancy() const
+{
+	uint32 InUse = 0;
+	for (const TPair<TObjectPtr<UClass>, FCombatActorPool>& Pair : Pools)
+	{
+		InUse += static_cast<uint32>(Pair.Value.NumInUse);
+	}
+	FEclipseLiveCounters::SetPoolOccupancy(InUse, static_cast<uint32>(Records.Num()));
+}
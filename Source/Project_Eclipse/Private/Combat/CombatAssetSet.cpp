@@ -0,0 +1,38 @@
+#include "Combat/CombatAssetSet.h"
+#include "Animation/AnimMontage.h"
+#include "Sound/SoundBase.h"
+#include "Particles/ParticleSystem.h"
+#include "Weapons/Weapon.h"
+
+const FName UCombatAssetSet::BundleName(TEXT("Combat"));
+
+bool UCombatAssetSet::IsLoaded() const
+{
+	return (AttackMontage.IsNull() || AttackMontage.Get())
+		&& (HitReactMontage.IsNull() || HitReactMontage.Get())
+		&& (DeathMontage.IsNull() || DeathMontage.Get())
+		&& (HitSound.IsNull() || HitSound.Get())
+		&& (HitParticles.IsNull() || HitParticles.Get())
+		&& (WeaponClass.IsNull() || WeaponClass.Get());
+}
+
+void UCombatAssetSet::GetBundlePaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	const FSoftObjectPath AllPaths[] =
+	{
+		AttackMontage.ToSoftObjectPath(),
+		HitReactMontage.ToSoftObjectPath(),
+		DeathMontage.ToSoftObjectPath(),
+		HitSound.ToSoftObjectPath(),
+		HitParticles.ToSoftObjectPath(),
+		WeaponClass.ToSoftObjectPath(),
+	};
+
+	for (const FSoftObjectPath& Path : AllPaths)
+	{
+		if (!Path.IsNull())
+		{
+			OutPaths.Add(Path);
+		}
+	}
+}
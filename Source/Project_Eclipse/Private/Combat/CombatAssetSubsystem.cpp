@@ -0,0 +1,257 @@
+#include "Combat/CombatAssetSubsystem.h"
+#include "Combat/CombatAssetSet.h"
+#include "Characters/BaseCharacter.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "AudioDevice.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Sound/SoundCue.h"
+#include "Sound/SoundNodeWavePlayer.h"
+#include "Sound/SoundWave.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GEclipseAssetsAsync = 1;
+static FAutoConsoleVariableRef CVarEclipseAssetsAsync(
+	TEXT("Eclipse.Assets.Async"),
+	GEclipseAssetsAsync,
+	TEXT("Load UCombatAssetSet bundles asynchronously.\n")
+	TEXT("0: block until loaded when requested, 1: stream in the background (default)"));
+
+static int32 GEclipseAssetsPrewarm = 1;
+static FAutoConsoleVariableRef CVarEclipseAssetsPrewarm(
+	TEXT("Eclipse.Assets.Prewarm"),
+	GEclipseAssetsPrewarm,
+	TEXT("Decompress montage animations and precache hit sounds as soon as a combat asset set has loaded."));
+
+void UCombatAssetSubsystem::RequestLoad(const UObject* WorldContextObject, UCombatAssetSet* Set, FSimpleDelegate OnLoaded)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UCombatAssetSubsystem* Subsystem = World ? World->GetSubsystem<UCombatAssetSubsystem>() : nullptr;
+	if (Set && Subsystem)
+	{
+		Subsystem->Load(Set, MoveTemp(OnLoaded));
+		return;
+	}
+
+	// Editor worlds: nothing to keep a handle in, so load in place
+	if (Set && !Set->IsLoaded())
+	{
+		TArray<FSoftObjectPath> Paths;
+		Set->GetBundlePaths(Paths);
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			Path.TryLoad();
+		}
+	}
+	OnLoaded.ExecuteIfBound();
+}
+
+void UCombatAssetSubsystem::PreloadCharacterClass(const UObject* WorldContextObject, TSubclassOf<ABaseCharacter> CharacterClass)
+{
+	if (CharacterClass)
+	{
+		RequestLoad(WorldContextObject, CharacterClass->GetDefaultObject<ABaseCharacter>()->GetCombatAssets());
+	}
+}
+
+bool UCombatAssetSubsystem::IsCharacterClassReady(const UObject* WorldContextObject, TSubclassOf<ABaseCharacter> CharacterClass)
+{
+	const UCombatAssetSet* Set = CharacterClass ? CharacterClass->GetDefaultObject<ABaseCharacter>()->GetCombatAssets() : nullptr;
+	if (!Set)
+	{
+		return true;
+	}
+
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UCombatAssetSubsystem* Subsystem = World ? World->GetSubsystem<UCombatAssetSubsystem>() : nullptr;
+	return Subsystem ? Subsystem->IsSetReady(Set) : Set->IsLoaded();
+}
+
+FString UCombatAssetSubsystem::GetLoadingModeLabel()
+{
+	return FString::Printf(TEXT("%s%s"), GEclipseAssetsAsync ? TEXT("Async") : TEXT("Sync"), GEclipseAssetsPrewarm ? TEXT("+Prewarm") : TEXT(""));
+}
+
+bool UCombatAssetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatAssetSubsystem::Deinitialize()
+{
+	for (TPair<TWeakObjectPtr<UCombatAssetSet>, FSetLoad>& Pair : Loads)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->ReleaseHandle();
+		}
+	}
+	Loads.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatAssetSubsystem::Load(UCombatAssetSet* Set, FSimpleDelegate OnLoaded)
+{
+	FSetLoad& SetLoad = Loads.FindOrAdd(Set);
+	if (SetLoad.bLoaded)
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	if (OnLoaded.IsBound())
+	{
+		SetLoad.OnLoaded.Add(MoveTemp(OnLoaded));
+	}
+
+	// Already in flight
+	if (SetLoad.Handle.IsValid())
+	{
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = StartLoad(Set);
+	Loads.FindChecked(Set).Handle = Handle;
+
+	// Nothing left to load, or a synchronous load; the completion delegate may or may not have run yet
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		OnSetLoaded(Set);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UCombatAssetSubsystem::StartLoad(UCombatAssetSet* Set)
+{
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const FStreamableDelegate OnComplete = FStreamableDelegate::CreateUObject(this, &UCombatAssetSubsystem::OnSetLoaded, TWeakObjectPtr<UCombatAssetSet>(Set));
+
+	TSharedPtr<FStreamableHandle> Handle;
+	const FPrimaryAssetId AssetId = Set->GetPrimaryAssetId();
+	if (AssetId.IsValid() && AssetManager.GetPrimaryAssetPath(AssetId).IsValid())
+	{
+		Handle = AssetManager.LoadPrimaryAsset(AssetId, { UCombatAssetSet::BundleName }, OnComplete);
+	}
+	else
+	{
+		// Not registered with the asset manager (see PrimaryAssetTypesToScan in DefaultGame.ini)
+		TArray<FSoftObjectPath> Paths;
+		Set->GetBundlePaths(Paths);
+		if (Paths.Num() > 0)
+		{
+			Handle = AssetManager.GetStreamableManager().RequestAsyncLoad(Paths, OnComplete);
+		}
+	}
+
+	if (Handle.IsValid() && !GEclipseAssetsAsync)
+	{
+		Handle->WaitUntilComplete();
+	}
+	return Handle;
+}
+
+void UCombatAssetSubsystem::OnSetLoaded(TWeakObjectPtr<UCombatAssetSet> WeakSet)
+{
+	UCombatAssetSet* Set = WeakSet.Get();
+	FSetLoad* SetLoad = Set ? Loads.Find(Set) : nullptr;
+	if (!SetLoad || SetLoad->bLoaded)
+	{
+		return;
+	}
+
+	SetLoad->bLoaded = true;
+	if (!Set->IsLoaded())
+	{
+		UE_LOG(LogEclipse, Warning, TEXT("Combat assets: %s has references that failed to load"), *Set->GetName());
+	}
+
+	if (GEclipseAssetsPrewarm)
+	{
+		Prewarm(Set);
+	}
+
+	// Callbacks may request more loads, which can reallocate Loads
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(SetLoad->OnLoaded);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+bool UCombatAssetSubsystem::IsSetReady(const UCombatAssetSet* Set) const
+{
+	// Keyed by a mutable set; the lookup doesn't modify it
+	const FSetLoad* SetLoad = Loads.Find(const_cast<UCombatAssetSet*>(Set));
+	return SetLoad ? SetLoad->bLoaded : Set->IsLoaded();
+}
+
+void UCombatAssetSubsystem::Prewarm(const UCombatAssetSet* Set)
+{
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseAssetPrewarm);
+
+	PrewarmMontage(Set->AttackMontage.Get());
+	PrewarmMontage(Set->HitReactMontage.Get());
+	PrewarmMontage(Set->DeathMontage.Get());
+	PrewarmSound(Set->HitSound.Get());
+}
+
+void UCombatAssetSubsystem::PrewarmMontage(const UAnimMontage* Montage)
+{
+	if (!Montage)
+	{
+		return;
+	}
+
+	// Reading a key of each sequence sets up its codec and pages its compressed data in
+	for (const FSlotAnimationTrack& SlotTrack : Montage->SlotAnimTracks)
+	{
+		for (const FAnimSegment& Segment : SlotTrack.AnimTrack.AnimSegments)
+		{
+			if (const UAnimSequence* Sequence = Cast<UAnimSequence>(Segment.GetAnimReference()))
+			{
+				FTransform RootTransform;
+				Sequence->GetBoneTransform(RootTransform, FSkeletonPoseBoneIndex(0), FAnimExtractContext(static_cast<double>(Segment.AnimStartTime)), false);
+			}
+		}
+	}
+}
+
+void UCombatAssetSubsystem::PrewarmSound(USoundBase* Sound)
+{
+	// Headless runs (-nosound, -nullrhi) have no device to decompress for
+	FAudioDevice* AudioDevice = Sound ? GetWorld()->GetAudioDeviceRaw() : nullptr;
+	if (!AudioDevice)
+	{
+		return;
+	}
+
+	TArray<USoundWave*, TInlineAllocator<4>> Waves;
+	if (USoundWave* Wave = Cast<USoundWave>(Sound))
+	{
+		Waves.Add(Wave);
+	}
+	else if (USoundCue* Cue = Cast<USoundCue>(Sound))
+	{
+		TArray<USoundNodeWavePlayer*> WavePlayers;
+		Cue->RecursiveFindNode<USoundNodeWavePlayer>(Cue->FirstNode, WavePlayers);
+		for (const USoundNodeWavePlayer* WavePlayer : WavePlayers)
+		{
+			if (USoundWave* CueWave = WavePlayer->GetSoundWave())
+			{
+				Waves.Add(CueWave);
+			}
+		}
+	}
+
+	for (USoundWave* Wave : Waves)
+	{
+		AudioDevice->Precache(Wave);
+	}
+}
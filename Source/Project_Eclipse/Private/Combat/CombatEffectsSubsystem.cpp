@@ -0,0 +1,299 @@
+#include "Combat/CombatEffectsSubsystem.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundConcurrency.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GEclipseFXPooled = 1;
+static FAutoConsoleVariableRef CVarEclipseFXPooled(
+	TEXT("Eclipse.FX.Pooled"),
+	GEclipseFXPooled,
+	TEXT("Play hit particles and sounds through UCombatEffectsSubsystem.\n")
+	TEXT("0: a new component and voice per hit, 1: pooled, merged and capped (default)"));
+
+static float GEclipseFXMergeRadius = 80.f;
+static FAutoConsoleVariableRef CVarEclipseFXMergeRadius(
+	TEXT("Eclipse.FX.MergeRadius"),
+	GEclipseFXMergeRadius,
+	TEXT("Same-frame impacts of one effect closer than this share a spawn. Grows with distance from the view."));
+
+static int32 GEclipseFXMaxPerFrame = 4;
+static FAutoConsoleVariableRef CVarEclipseFXMaxPerFrame(
+	TEXT("Eclipse.FX.MaxPerFrame"),
+	GEclipseFXMaxPerFrame,
+	TEXT("Spawns per effect per frame; further impacts merge into the nearest."));
+
+static int32 GEclipseFXMaxActive = 12;
+static FAutoConsoleVariableRef CVarEclipseFXMaxActive(
+	TEXT("Eclipse.FX.MaxActive"),
+	GEclipseFXMaxActive,
+	TEXT("Live particle systems per effect; impacts beyond it are merged or dropped."));
+
+static int32 GEclipseFXMaxVoices = 6;
+static FAutoConsoleVariableRef CVarEclipseFXMaxVoices(
+	TEXT("Eclipse.FX.MaxVoices"),
+	GEclipseFXMaxVoices,
+	TEXT("Voices per hit sound; the farthest is stopped first. Read when the sound first plays in a world."));
+
+static float GEclipseFXCullDistance = 6000.f;
+static FAutoConsoleVariableRef CVarEclipseFXCullDistance(
+	TEXT("Eclipse.FX.CullDistance"),
+	GEclipseFXCullDistance,
+	TEXT("Hit particles farther than this from every local view are not spawned."));
+
+void UCombatEffectsSubsystem::PlayHitEffects(const UObject* WorldContextObject, UFXSystemAsset* Particles, USoundBase* Sound, const FVector& Location)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || World->GetNetMode() == NM_DedicatedServer || (!Particles && !Sound))
+	{
+		return;
+	}
+
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseHitEffects);
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+
+	UCombatEffectsSubsystem* Subsystem = World->GetSubsystem<UCombatEffectsSubsystem>();
+	if (!Subsystem || !GEclipseFXPooled)
+	{
+		if (Particles)
+		{
+			SpawnParticles(World, Particles, Location, false);
+			INC_DWORD_STAT(STAT_EclipseEffectsSpawned);
+		}
+		if (Sound)
+		{
+			UGameplayStatics::PlaySoundAtLocation(World, Sound, Location);
+		}
+		return;
+	}
+
+	ECLIPSE_PERF_BUDGET(HitEffects, 40.0);
+
+	Subsystem->BeginFrame();
+	const float ViewDistance = Subsystem->GetViewDistance(Location);
+	if (Particles)
+	{
+		Subsystem->PlayParticles(Particles, Location, ViewDistance);
+	}
+	if (Sound)
+	{
+		Subsystem->PlaySound(Sound, Location, ViewDistance);
+	}
+}
+
+bool UCombatEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatEffectsSubsystem::Deinitialize()
+{
+	FrameImpacts.Empty();
+	ActiveParticles.Empty();
+	SoundConcurrency.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatEffectsSubsystem::BeginFrame()
+{
+	if (Frame == GFrameCounter)
+	{
+		return;
+	}
+
+	Frame = GFrameCounter;
+	FrameImpacts.Reset();
+
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+void UCombatEffectsSubsystem::PlayParticles(UFXSystemAsset* Particles, const FVector& Location, float ViewDistance)
+{
+	if (ViewDistance > GEclipseFXCullDistance)
+	{
+		INC_DWORD_STAT(STAT_EclipseEffectsCulled);
+		return;
+	}
+
+	if (TryMerge(Particles, Location, ViewDistance, false))
+	{
+		return;
+	}
+
+	if (CountFrameSpawns(Particles) >= GEclipseFXMaxPerFrame || !HasActiveRoom(Particles))
+	{
+		if (!TryMerge(Particles, Location, ViewDistance, true))
+		{
+			INC_DWORD_STAT(STAT_EclipseEffectsCulled);
+		}
+		return;
+	}
+
+	UFXSystemComponent* Component = SpawnParticles(GetWorld(), Particles, Location, true);
+	if (!Component)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_EclipseEffectsSpawned);
+	ActiveParticles.FindOrAdd(Particles).Add(Component);
+
+	FFrameImpact& Impact = FrameImpacts.AddDefaulted_GetRef();
+	Impact.Effect = Particles;
+	Impact.LocationSum = Location;
+	Impact.Count = 1;
+	Impact.Component = Component;
+}
+
+void UCombatEffectsSubsystem::PlaySound(USoundBase* Sound, const FVector& Location, float ViewDistance)
+{
+	if (ViewLocations.Num() > 0 && ViewDistance > Sound->GetMaxDistance())
+	{
+		INC_DWORD_STAT(STAT_EclipseEffectsCulled);
+		return;
+	}
+
+	// A merged sound keeps playing where its first impact was
+	if (TryMerge(Sound, Location, ViewDistance, CountFrameSpawns(Sound) >= GEclipseFXMaxPerFrame))
+	{
+		return;
+	}
+
+	UGameplayStatics::PlaySoundAtLocation(GetWorld(), Sound, Location, 1.f, 1.f, 0.f, nullptr, GetConcurrency(Sound));
+
+	FFrameImpact& Impact = FrameImpacts.AddDefaulted_GetRef();
+	Impact.Effect = Sound;
+	Impact.LocationSum = Location;
+	Impact.Count = 1;
+}
+
+bool UCombatEffectsSubsystem::TryMerge(const UObject* Effect, const FVector& Location, float ViewDistance, bool bAnyDistance)
+{
+	const float Radius = GEclipseFXMergeRadius * FMath::Max(1.f, ViewDistance / FullDetailDistance);
+	float NearestDistanceSq = bAnyDistance ? TNumericLimits<float>::Max() : FMath::Square(Radius);
+	FFrameImpact* Nearest = nullptr;
+	for (FFrameImpact& Impact : FrameImpacts)
+	{
+		if (Impact.Effect != Effect)
+		{
+			continue;
+		}
+
+		const float DistanceSq = FVector::DistSquared(Impact.GetLocation(), Location);
+		if (DistanceSq <= NearestDistanceSq)
+		{
+			NearestDistanceSq = DistanceSq;
+			Nearest = &Impact;
+		}
+	}
+
+	if (!Nearest)
+	{
+		return false;
+	}
+
+	Nearest->LocationSum += Location;
+	++Nearest->Count;
+	if (UFXSystemComponent* Component = Nearest->Component.Get())
+	{
+		Component->SetWorldLocation(Nearest->GetLocation());
+	}
+
+	INC_DWORD_STAT(STAT_EclipseEffectsMerged);
+	return true;
+}
+
+int32 UCombatEffectsSubsystem::CountFrameSpawns(const UObject* Effect) const
+{
+	int32 Count = 0;
+	for (const FFrameImpact& Impact : FrameImpacts)
+	{
+		Count += Impact.Effect == Effect ? 1 : 0;
+	}
+	return Count;
+}
+
+bool UCombatEffectsSubsystem::HasActiveRoom(const UFXSystemAsset* Particles)
+{
+	TArray<TWeakObjectPtr<UFXSystemComponent>>* Active = ActiveParticles.Find(Particles);
+	if (!Active)
+	{
+		return GEclipseFXMaxActive > 0;
+	}
+
+	// Finished components go back to the engine pool and may be handed out again with another asset
+	Active->RemoveAllSwap([Particles](const TWeakObjectPtr<UFXSystemComponent>& Component)
+	{
+		return !Component.IsValid() || !Component->IsActive() || Component->GetFXSystemAsset() != Particles;
+	}, EAllowShrinking::No);
+
+	return Active->Num() < GEclipseFXMaxActive;
+}
+
+float UCombatEffectsSubsystem::GetViewDistance(const FVector& Location) const
+{
+	// No local view (headless runs): everything is full detail
+	if (ViewLocations.Num() == 0)
+	{
+		return 0.f;
+	}
+
+	float NearestSq = TNumericLimits<float>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		NearestSq = FMath::Min(NearestSq, static_cast<float>(FVector::DistSquared(ViewLocation, Location)));
+	}
+	return FMath::Sqrt(NearestSq);
+}
+
+USoundConcurrency* UCombatEffectsSubsystem::GetConcurrency(USoundBase* Sound)
+{
+	TObjectPtr<USoundConcurrency>& Concurrency = SoundConcurrency.FindOrAdd(Sound);
+	if (!Concurrency)
+	{
+		Concurrency = NewObject<USoundConcurrency>(this);
+		Concurrency->Concurrency.MaxCount = FMath::Max(1, GEclipseFXMaxVoices);
+		Concurrency->Concurrency.bLimitToOwner = false;
+		Concurrency->Concurrency.ResolutionRule = EMaxConcurrentResolutionRule::StopFarthestThenOldest;
+	}
+	return Concurrency;
+}
+
+UFXSystemComponent* UCombatEffectsSubsystem::SpawnParticles(UWorld* World, UFXSystemAsset* Particles, const FVector& Location, bool bPooled)
+{
+	if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Particles))
+	{
+		return UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, NiagaraSystem, Location, FRotator::ZeroRotator, FVector(1.f),
+			!bPooled, true, bPooled ? ENCPoolMethod::AutoRelease : ENCPoolMethod::None);
+	}
+
+	if (UParticleSystem* ParticleSystem = Cast<UParticleSystem>(Particles))
+	{
+		return UGameplayStatics::SpawnEmitterAtLocation(World, ParticleSystem, FTransform(Location),
+			!bPooled, bPooled ? EPSCPoolMethod::AutoRelease : EPSCPoolMethod::None);
+	}
+
+	return nullptr;
+}
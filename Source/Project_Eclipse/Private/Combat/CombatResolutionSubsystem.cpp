@@ -0,0 +1,189 @@
+#include "Combat/CombatResolutionSubsystem.h"
+#include "Enemy/Enemy.h"
+#include "HUD/MainHUD.h"
+#include "Interfaces/HitInterface.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Engine/World.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+static int32 GEclipseCombatDeferHits = 1;
+static FAutoConsoleVariableRef CVarEclipseCombatDeferHits(
+	TEXT("Eclipse.Combat.DeferHits"),
+	GEclipseCombatDeferHits,
+	TEXT("Resolve weapon and kick hits once per frame in UCombatResolutionSubsystem.\n")
+	TEXT("0: resolve each hit when it is found, 1: batch at the end of the frame (default)"));
+
+void UCombatResolutionSubsystem::QueueHit(const UObject* WorldContextObject, const FCombatHitCandidate& Hit)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UCombatResolutionSubsystem* Subsystem = World ? World->GetSubsystem<UCombatResolutionSubsystem>() : nullptr;
+	if (Subsystem && GEclipseCombatDeferHits)
+	{
+		Subsystem->Enqueue(Hit);
+		return;
+	}
+
+	if (APlayerController* PlayerController = ResolveHit(Hit))
+	{
+		if (AMainHUD* MainHUD = Cast<AMainHUD>(PlayerController->GetHUD()))
+		{
+			MainHUD->SetTargetedEnemy(Cast<AEnemy>(Hit.Victim.Get()));
+		}
+	}
+}
+
+bool UCombatResolutionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatResolutionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// A busy frame in the benchmark stays well under this, so queueing never allocates
+	PendingHits.Reserve(64);
+	ResolvingHits.Reserve(64);
+	TargetUpdates.Reserve(4);
+}
+
+TStatId UCombatResolutionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatResolutionSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatResolutionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingHits.Num() > 0)
+	{
+		ResolvePending();
+	}
+}
+
+void UCombatResolutionSubsystem::Enqueue(const FCombatHitCandidate& Hit)
+{
+	FCombatHitCandidate& Queued = PendingHits.Add_GetRef(Hit);
+	Queued.Sequence = NextSequence++;
+}
+
+void UCombatResolutionSubsystem::ResolvePending()
+{
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseCombatResolve);
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+
+	// Hits queued while resolving (none today) wait for the next frame instead of growing the array being walked
+	Swap(PendingHits, ResolvingHits);
+	PendingHits.Reset();
+
+	// Group by attacker, then victim, in queue order within a pair
+	ResolvingHits.Sort([](const FCombatHitCandidate& A, const FCombatHitCandidate& B)
+	{
+		const uint32 AttackerA = A.Attacker.IsValid() ? A.Attacker->GetUniqueID() : 0;
+		const uint32 AttackerB = B.Attacker.IsValid() ? B.Attacker->GetUniqueID() : 0;
+		if (AttackerA != AttackerB)
+		{
+			return AttackerA < AttackerB;
+		}
+
+		const uint32 VictimA = A.Victim.IsValid() ? A.Victim->GetUniqueID() : 0;
+		const uint32 VictimB = B.Victim.IsValid() ? B.Victim->GetUniqueID() : 0;
+		if (VictimA != VictimB)
+		{
+			return VictimA < VictimB;
+		}
+		return A.Sequence < B.Sequence;
+	});
+
+	TargetUpdates.Reset();
+	int32 PairStart = 0;
+	for (int32 HitIndex = 0; HitIndex < ResolvingHits.Num(); ++HitIndex)
+	{
+		const FCombatHitCandidate& Hit = ResolvingHits[HitIndex];
+		if (ResolvingHits[PairStart].Attacker != Hit.Attacker || ResolvingHits[PairStart].Victim != Hit.Victim)
+		{
+			PairStart = HitIndex;
+		}
+
+		// One hit per damage causer and shape for each attacker and victim; a kick and a blade landing together both count
+		bool bDuplicate = false;
+		for (int32 EarlierIndex = PairStart; EarlierIndex < HitIndex && !bDuplicate; ++EarlierIndex)
+		{
+			bDuplicate = ResolvingHits[EarlierIndex].DamageCauser == Hit.DamageCauser && ResolvingHits[EarlierIndex].Shape == Hit.Shape;
+		}
+		if (bDuplicate)
+		{
+			continue;
+		}
+
+		if (APlayerController* PlayerController = ResolveHit(Hit))
+		{
+			// The queue is sorted by attacker and victim, so the latest hit is found by its sequence
+			FTargetUpdate* Existing = TargetUpdates.FindByPredicate([PlayerController](const FTargetUpdate& Update)
+			{
+				return Update.PlayerController == PlayerController;
+			});
+			if (!Existing)
+			{
+				TargetUpdates.Add({ PlayerController, Hit.Victim.Get(), Hit.Sequence });
+			}
+			else if (Hit.Sequence > Existing->Sequence)
+			{
+				Existing->Victim = Hit.Victim.Get();
+				Existing->Sequence = Hit.Sequence;
+			}
+		}
+	}
+	ResolvingHits.Reset();
+
+	for (const FTargetUpdate& Update : TargetUpdates)
+	{
+		AEnemy* HitEnemy = Cast<AEnemy>(Update.Victim);
+		AMainHUD* MainHUD = Cast<AMainHUD>(Update.PlayerController->GetHUD());
+		if (HitEnemy && MainHUD)
+		{
+			MainHUD->SetTargetedEnemy(HitEnemy);
+		}
+	}
+}
+
+APlayerController* UCombatResolutionSubsystem::ResolveHit(const FCombatHitCandidate& Hit)
+{
+	AActor* Victim = Hit.Victim.Get();
+	AActor* Attacker = Hit.Attacker.Get();
+	if (!Victim || !Attacker)
+	{
+		return nullptr;
+	}
+
+	AController* InstigatorController = Hit.InstigatorController.Get();
+
+	INC_DWORD_STAT(STAT_EclipseDamageApplications);
+	FEclipseLiveCounters::CountDamageEvent();
+	ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::ApplyDamage, Attacker, Victim, Hit.Damage, Hit.ImpactPoint);
+	ECLIPSE_LATENCY_MARK(Attacker, Damage);
+	UGameplayStatics::ApplyDamage(
+		Victim,
+		Hit.Damage,
+		InstigatorController,
+		Hit.DamageCauser.Get(),
+		UDamageType::StaticClass()
+	);
+
+	// Hit reaction, sound and particles
+	if (IHitInterface* HitInterface = Cast<IHitInterface>(Victim))
+	{
+		HitInterface->GetHit(Hit.ImpactPoint);
+	}
+
+	return Cast<AEnemy>(Victim) ? Cast<APlayerController>(InstigatorController) : nullptr;
+}
@@ -0,0 +1,88 @@
+#include "Combat/EclipseCollision.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GEclipseCollisionLegacyProfiles = 0;
+static FAutoConsoleVariableRef CVarEclipseCollisionLegacyProfiles(
+	TEXT("Eclipse.Collision.LegacyProfiles"),
+	GEclipseCollisionLegacyProfiles,
+	TEXT("Use the pre-profile weapon and hurtbox collision for actors that begin play from now on.\n")
+	TEXT("0: WeaponHitbox/CombatHurtbox profiles (default), 1: weapons overlap every Pawn component"));
+
+static uint64 GEclipseOverlapCallbacks = 0;
+
+const FName FEclipseCollision::WeaponHitboxProfile(TEXT("WeaponHitbox"));
+const FName FEclipseCollision::CombatHurtboxProfile(TEXT("CombatHurtbox"));
+
+void FEclipseCollision::InitWeaponHitbox(UPrimitiveComponent* Component)
+{
+	if (Component)
+	{
+		Component->SetCollisionProfileName(WeaponHitboxProfile);
+		Component->SetGenerateOverlapEvents(true);
+
+		// Hit windows turn collision on
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+}
+
+void FEclipseCollision::InitHurtbox(UPrimitiveComponent* Component)
+{
+	if (Component)
+	{
+		Component->SetCollisionProfileName(CombatHurtboxProfile);
+
+		// Overlap events need both sides; the weapon side does the filtering
+		Component->SetGenerateOverlapEvents(true);
+	}
+}
+
+void FEclipseCollision::InitCharacterMesh(UPrimitiveComponent* Component)
+{
+	if (Component)
+	{
+		// No physics bodies; hit zones are tested against the pose by UHurtboxComponent
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetGenerateOverlapEvents(false);
+	}
+}
+
+void FEclipseCollision::ApplyLegacyHitbox(UPrimitiveComponent* Component)
+{
+	if (Component && UseLegacyProfiles())
+	{
+		Component->SetCollisionObjectType(ECC_WorldDynamic);
+		Component->SetCollisionResponseToAllChannels(ECR_Ignore);
+		Component->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+	}
+}
+
+void FEclipseCollision::ApplyLegacyCharacterMesh(UPrimitiveComponent* Component)
+{
+	if (Component && UseLegacyProfiles())
+	{
+		// Meshes used to keep their physics bodies for the weapon trace
+		Component->SetCollisionProfileName(UCollisionProfile::CustomCollisionProfileName);
+		Component->SetCollisionObjectType(ECC_WorldDynamic);
+		Component->SetCollisionResponseToAllChannels(ECR_Block);
+		Component->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+		Component->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
+		Component->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	}
+}
+
+bool FEclipseCollision::UseLegacyProfiles()
+{
+	return GEclipseCollisionLegacyProfiles != 0;
+}
+
+void FEclipseCollision::CountOverlapCallback()
+{
+	++GEclipseOverlapCallbacks;
+}
+
+uint64 FEclipseCollision::GetOverlapCallbackCount()
+{
+	return GEclipseOverlapCallbacks;
+}
@@ -41,6 +41,11 @@ bool UAttributeComponent::IsAlive()
 	return Health > 0.f;
 }
 
+void UAttributeComponent::ResetHealth()
+{
+	Health = MaxHealth;
+}
+
 
 
 
@@ -0,0 +1,271 @@
+#include "Components/HitboxComponent.h"
+#include "Characters/BaseCharacter.h"
+#include "Combat/CombatResolutionSubsystem.h"
+#include "Combat/EclipseCollision.h"
+#include "Animation/AttackTrajectoryAsset.h"
+#include "Interfaces/HitInterface.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+
+UHitboxComponent::UHitboxComponent()
+{
+	// Ticks only while a shape is active, after animation has posed the sockets
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UHitboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OwnerCharacter = Cast<ABaseCharacter>(GetOwner());
+	DefaultAttachComponent = OwnerCharacter ? static_cast<USceneComponent*>(OwnerCharacter->GetMesh()) : (GetOwner() ? GetOwner()->GetRootComponent() : nullptr);
+
+	IgnoreActors.Reserve(8);
+	Overlaps.Reserve(16);
+	Hits.Reserve(8);
+}
+
+void UHitboxComponent::AddOrUpdateShape(const FHitboxShape& Shape)
+{
+	FHitboxShape* Existing = Shapes.FindByPredicate([&Shape](const FHitboxShape& Other) { return Other.Name == Shape.Name; });
+	if (!Existing)
+	{
+		Shapes.Add(Shape);
+		Shapes.Last().bActive = false;
+		return;
+	}
+
+	// Keep the runtime state so a shape can be redefined while active
+	const bool bWasActive = Existing->bActive;
+	const FVector LastStart = Existing->LastStart;
+	const FVector LastEnd = Existing->LastEnd;
+	*Existing = Shape;
+	Existing->bActive = bWasActive;
+	Existing->LastStart = LastStart;
+	Existing->LastEnd = LastEnd;
+}
+
+void UHitboxComponent::ActivateBlade(USceneComponent* AttachComponent, const FVector& LocalStart, const FVector& LocalEnd, float Radius, float Damage, AActor* DamageCauser)
+{
+	FHitboxShape Blade;
+	Blade.Name = UAttackTrajectoryAsset::BladeTrackName;
+	Blade.TrajectoryTrack = UAttackTrajectoryAsset::BladeTrackName;
+	Blade.AttachComponent = AttachComponent;
+	Blade.LocalStart = LocalStart;
+	Blade.LocalEnd = LocalEnd;
+	Blade.Radius = Radius;
+	Blade.Damage = Damage;
+	Blade.DamageCauser = DamageCauser;
+	AddOrUpdateShape(Blade);
+	SetShapeActive(UAttackTrajectoryAsset::BladeTrackName, true);
+}
+
+void UHitboxComponent::DeactivateBlade()
+{
+	SetShapeActive(UAttackTrajectoryAsset::BladeTrackName, false);
+}
+
+void UHitboxComponent::SetShapeActive(FName ShapeName, bool bActive)
+{
+	FHitboxShape* Shape = Shapes.FindByPredicate([ShapeName](const FHitboxShape& Other) { return Other.Name == ShapeName; });
+	if (!Shape || Shape->bActive == bActive)
+	{
+		return;
+	}
+
+	if (bActive && NumActiveShapes == 0)
+	{
+		RebuildIgnoreActors();
+	}
+
+	Shape->bActive = bActive;
+	NumActiveShapes += bActive ? 1 : -1;
+	if (bActive)
+	{
+		// The first sweep starts where the shape is now
+		GetShapeSegment(*Shape, Shape->LastStart, Shape->LastEnd);
+	}
+
+	SetComponentTickEnabled(NumActiveShapes > 0);
+}
+
+void UHitboxComponent::DeactivateAllShapes()
+{
+	for (FHitboxShape& Shape : Shapes)
+	{
+		Shape.bActive = false;
+	}
+	NumActiveShapes = 0;
+	SetComponentTickEnabled(false);
+}
+
+void UHitboxComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (NumActiveShapes > 0)
+	{
+		EvaluateShapes();
+	}
+}
+
+void UHitboxComponent::GetShapeSegment(const FHitboxShape& Shape, FVector& OutStart, FVector& OutEnd) const
+{
+	if (!Shape.TrajectoryTrack.IsNone() && OwnerCharacter && OwnerCharacter->GetBakedAttackSegment(Shape.TrajectoryTrack, OutStart, OutEnd))
+	{
+		return;
+	}
+
+	const USceneComponent* AttachComponent = Shape.AttachComponent ? Shape.AttachComponent.Get() : DefaultAttachComponent;
+	const FTransform SocketTransform = AttachComponent ? AttachComponent->GetSocketTransform(Shape.Socket) : FTransform::Identity;
+	OutStart = SocketTransform.TransformPosition(Shape.LocalStart);
+	OutEnd = SocketTransform.TransformPosition(Shape.LocalEnd);
+}
+
+void UHitboxComponent::RebuildIgnoreActors()
+{
+	IgnoreActors.Reset();
+	if (AActor* OwnerActor = GetOwner())
+	{
+		IgnoreActors.Add(OwnerActor);
+		OwnerActor->GetAttachedActors(IgnoreActors, false, true);
+	}
+}
+
+void UHitboxComponent::EvaluateShapes()
+{
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseHitboxQuery);
+	ECLIPSE_PERF_BUDGET(HitboxQuery, 60.0);
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+	ECLIPSE_ALLOC_SCOPE(HitboxQuery);
+
+	AActor* OwnerActor = GetOwner();
+	if (!OwnerActor || !OwnerCharacter)
+	{
+		return;
+	}
+
+	// One box around last and current pose of every active shape
+	FBox QueryBounds(ForceInit);
+	float MaxRadius = 0.f;
+	for (FHitboxShape& Shape : Shapes)
+	{
+		if (Shape.bActive)
+		{
+			GetShapeSegment(Shape, Shape.CurrentStart, Shape.CurrentEnd);
+			QueryBounds += Shape.LastStart;
+			QueryBounds += Shape.LastEnd;
+			QueryBounds += Shape.CurrentStart;
+			QueryBounds += Shape.CurrentEnd;
+			MaxRadius = FMath::Max(MaxRadius, Shape.Radius);
+		}
+	}
+
+	Overlaps.Reset();
+	Hits.Reset();
+	if (QueryBounds.IsValid && OwnerCharacter->IsAttacking())
+	{
+		QueryBounds = QueryBounds.ExpandBy(MaxRadius);
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(EclipseHitboxQuery), false);
+		Params.AddIgnoredActors(IgnoreActors);
+
+		INC_DWORD_STAT(STAT_EclipseTraces);
+		FEclipseLiveCounters::CountTrace();
+		const FCollisionShape QueryShape = FCollisionShape::MakeBox(QueryBounds.GetExtent());
+		if (FEclipseCollision::UseLegacyProfiles())
+		{
+			GetWorld()->OverlapMultiByObjectType(Overlaps, QueryBounds.GetCenter(), FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), QueryShape, Params);
+		}
+		else
+		{
+			GetWorld()->OverlapMultiByChannel(Overlaps, QueryBounds.GetCenter(), FQuat::Identity, FEclipseCollision::WeaponChannel, QueryShape, Params);
+		}
+	}
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		UPrimitiveComponent* Candidate = Overlap.GetComponent();
+		AActor* Victim = Overlap.GetActor();
+		IHitInterface* HitInterface = Cast<IHitInterface>(Victim);
+		const FCombatHitLedger* Ledger = HitInterface ? HitInterface->GetHitLedger() : nullptr;
+		if (!Candidate || !Ledger || OwnerCharacter->HasAlreadyHit(Victim))
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_EclipseOverlaps);
+		FEclipseLiveCounters::CountOverlap();
+
+		// Each shape's capsule swept from last frame's pose to this one, against this capsule and then the victim's hit zones
+		for (int32 ShapeIndex = 0; ShapeIndex < Shapes.Num(); ++ShapeIndex)
+		{
+			const FHitboxShape& Shape = Shapes[ShapeIndex];
+			if (!Shape.bActive)
+			{
+				continue;
+			}
+
+			const FVector SweepStart = (Shape.LastStart + Shape.LastEnd) * 0.5f;
+			const FVector SweepEnd = (Shape.CurrentStart + Shape.CurrentEnd) * 0.5f;
+			const FVector Axis = ((Shape.LastEnd - Shape.LastStart) + (Shape.CurrentEnd - Shape.CurrentStart)) * 0.5f;
+			const FQuat Rotation = Axis.IsNearlyZero() ? FQuat::Identity : FRotationMatrix::MakeFromZ(Axis).ToQuat();
+			const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Shape.Radius, Axis.Size() * 0.5f + Shape.Radius);
+
+			FHitResult Hit;
+			FHitZoneResult Zone;
+			if (Candidate->SweepComponent(Hit, SweepStart, SweepEnd, Rotation, Capsule)
+				&& UHurtboxComponent::ConfirmHit(Victim, Shape.LastStart, Shape.LastEnd, Shape.CurrentStart, Shape.CurrentEnd, Shape.Radius,
+					Hit.bStartPenetrating ? SweepEnd : FVector(Hit.ImpactPoint), Zone)
+				&& OwnerCharacter->TryRecordHit(Victim))
+			{
+				FHitboxHit& NewHit = Hits.AddDefaulted_GetRef();
+				NewHit.ShapeIndex = ShapeIndex;
+				NewHit.Victim = Victim;
+				NewHit.Zone = Zone;
+				break;
+			}
+		}
+	}
+
+	for (FHitboxShape& Shape : Shapes)
+	{
+		Shape.LastStart = Shape.CurrentStart;
+		Shape.LastEnd = Shape.CurrentEnd;
+	}
+
+	ECLIPSE_ALLOC_SCOPE_END(HitboxQuery);
+
+	if (Hits.Num() == 0)
+	{
+		return;
+	}
+
+	AController* InstigatorController = OwnerCharacter->GetController();
+	for (const FHitboxHit& HitboxHit : Hits)
+	{
+		const FHitboxShape& Shape = Shapes[HitboxHit.ShapeIndex];
+		ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::BoxTrace, OwnerActor, HitboxHit.Victim.Get(), 1.f, HitboxHit.Zone.ImpactPoint);
+		ECLIPSE_LATENCY_MARK(OwnerActor, FirstContact);
+
+		// Damage, reaction and HUD are applied by the resolution subsystem at the end of the frame
+		FCombatHitCandidate Candidate;
+		Candidate.Attacker = OwnerActor;
+		Candidate.Victim = HitboxHit.Victim;
+		Candidate.DamageCauser = Shape.DamageCauser.IsValid() ? Shape.DamageCauser.Get() : OwnerActor;
+		Candidate.Shape = Shape.Name;
+		Candidate.InstigatorController = InstigatorController;
+		Candidate.Damage = Shape.Damage * HitboxHit.Zone.DamageMultiplier;
+		Candidate.ImpactPoint = HitboxHit.Zone.ImpactPoint;
+		UCombatResolutionSubsystem::QueueHit(this, Candidate);
+	}
+}
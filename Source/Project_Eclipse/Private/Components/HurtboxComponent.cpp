@@ -0,0 +1,263 @@
+#include "Components/HurtboxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Interfaces/HitInterface.h"
+#include "GameFramework/Character.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+#include "HAL/IConsoleManager.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+
+static int32 GEclipseCombatHitZones = 1;
+static FAutoConsoleVariableRef CVarEclipseCombatHitZones(
+	TEXT("Eclipse.Combat.HitZones"),
+	GEclipseCombatHitZones,
+	TEXT("Test hits that pass a character's capsule against its hit zone bodies.\n")
+	TEXT("0: the capsule hit stands and deals torso damage, 1: per-bone narrow phase with zone multipliers (default)"));
+
+namespace
+{
+	// Enough steps for fast swings; each step moves at most the attack radius plus the thinnest body
+	constexpr int32 MaxNarrowphaseSteps = 8;
+
+	FHitZone MakeHitZone(EHitZone Zone, float DamageMultiplier, std::initializer_list<const TCHAR*> Bones)
+	{
+		FHitZone HitZone;
+		HitZone.Zone = Zone;
+		HitZone.DamageMultiplier = DamageMultiplier;
+		for (const TCHAR* Bone : Bones)
+		{
+			HitZone.Bones.Add(FName(Bone));
+		}
+		return HitZone;
+	}
+}
+
+UHurtboxComponent::UHurtboxComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Mannequin bone names
+	HitZones.Add(MakeHitZone(EHitZone::Head, 2.f, { TEXT("head"), TEXT("neck_01") }));
+	HitZones.Add(MakeHitZone(EHitZone::Torso, 1.f, { TEXT("pelvis"), TEXT("spine_01"), TEXT("spine_02"), TEXT("spine_03"), TEXT("spine_04"), TEXT("spine_05") }));
+	HitZones.Add(MakeHitZone(EHitZone::Arm, 0.75f, { TEXT("clavicle_l"), TEXT("upperarm_l"), TEXT("lowerarm_l"), TEXT("hand_l"),
+		TEXT("clavicle_r"), TEXT("upperarm_r"), TEXT("lowerarm_r"), TEXT("hand_r") }));
+	HitZones.Add(MakeHitZone(EHitZone::Leg, 0.75f, { TEXT("thigh_l"), TEXT("calf_l"), TEXT("foot_l"), TEXT("thigh_r"), TEXT("calf_r"), TEXT("foot_r") }));
+}
+
+void UHurtboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (const ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner()))
+	{
+		Mesh = OwnerCharacter->GetMesh();
+	}
+	CacheBodies();
+}
+
+bool UHurtboxComponent::UseHitZones()
+{
+	return GEclipseCombatHitZones != 0;
+}
+
+bool UHurtboxComponent::ConfirmHit(AActor* Victim, const FVector& PrevStart, const FVector& PrevEnd, const FVector& CurStart, const FVector& CurEnd,
+	float Radius, const FVector& FallbackImpact, FHitZoneResult& OutResult)
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(Victim);
+	const UHurtboxComponent* Hurtbox = HitInterface ? HitInterface->GetHurtbox() : nullptr;
+	if (!Hurtbox || !Hurtbox->HasHitZones())
+	{
+		OutResult = FHitZoneResult();
+		OutResult.ImpactPoint = FallbackImpact;
+		return true;
+	}
+	return Hurtbox->SweepHitZones(PrevStart, PrevEnd, CurStart, CurEnd, Radius, OutResult);
+}
+
+void UHurtboxComponent::ClassifyHit(AActor* Victim, const FVector& ImpactPoint, FHitZoneResult& OutResult)
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(Victim);
+	if (const UHurtboxComponent* Hurtbox = HitInterface ? HitInterface->GetHurtbox() : nullptr)
+	{
+		Hurtbox->FindNearestZone(ImpactPoint, OutResult);
+		return;
+	}
+	OutResult = FHitZoneResult();
+	OutResult.ImpactPoint = ImpactPoint;
+}
+
+void UHurtboxComponent::CacheBodies()
+{
+	Bodies.Reset();
+	MinBodyRadius = 0.f;
+	if (!HitZoneAsset || !Mesh)
+	{
+		return;
+	}
+
+	for (const USkeletalBodySetup* BodySetup : HitZoneAsset->SkeletalBodySetups)
+	{
+		if (!BodySetup)
+		{
+			continue;
+		}
+
+		const int32 BoneIndex = Mesh->GetBoneIndex(BodySetup->BoneName);
+		if (BoneIndex == INDEX_NONE)
+		{
+			ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("%s: Hit zone bone %s is not on the mesh"), *GetNameSafe(GetOwner()), *BodySetup->BoneName.ToString());
+			continue;
+		}
+
+		const int32 ZoneIndex = HitZones.IndexOfByPredicate([&BodySetup](const FHitZone& Zone) { return Zone.Bones.Contains(BodySetup->BoneName); });
+		const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+		for (const FKSphylElem& Sphyl : AggGeom.SphylElems)
+		{
+			const FTransform ElemTransform = Sphyl.GetTransform();
+			const FVector HalfAxis(0.f, 0.f, Sphyl.Length * 0.5f);
+			AddBody(BoneIndex, ZoneIndex, ElemTransform.TransformPosition(-HalfAxis), ElemTransform.TransformPosition(HalfAxis), Sphyl.Radius);
+		}
+		for (const FKTaperedCapsuleElem& Tapered : AggGeom.TaperedCapsuleElems)
+		{
+			const FTransform ElemTransform = Tapered.GetTransform();
+			const FVector HalfAxis(0.f, 0.f, Tapered.Length * 0.5f);
+			AddBody(BoneIndex, ZoneIndex, ElemTransform.TransformPosition(-HalfAxis), ElemTransform.TransformPosition(HalfAxis), FMath::Max(Tapered.Radius0, Tapered.Radius1));
+		}
+		for (const FKSphereElem& Sphere : AggGeom.SphereElems)
+		{
+			AddBody(BoneIndex, ZoneIndex, Sphere.Center, Sphere.Center, Sphere.Radius);
+		}
+		for (const FKBoxElem& Box : AggGeom.BoxElems)
+		{
+			// Capsule along the longest side, as thick as the box
+			const FVector HalfExtent(Box.X * 0.5f, Box.Y * 0.5f, Box.Z * 0.5f);
+			const int32 LongAxis = HalfExtent.X >= HalfExtent.Y ? (HalfExtent.X >= HalfExtent.Z ? 0 : 2) : (HalfExtent.Y >= HalfExtent.Z ? 1 : 2);
+			const float Radius = FMath::Max(HalfExtent[(LongAxis + 1) % 3], HalfExtent[(LongAxis + 2) % 3]);
+			FVector HalfAxis = FVector::ZeroVector;
+			HalfAxis[LongAxis] = FMath::Max(HalfExtent[LongAxis] - Radius, 0.f);
+			const FTransform ElemTransform = Box.GetTransform();
+			AddBody(BoneIndex, ZoneIndex, ElemTransform.TransformPosition(-HalfAxis), ElemTransform.TransformPosition(HalfAxis), Radius);
+		}
+	}
+
+	if (Bodies.Num() > 16)
+	{
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("%s: %s has %d hit zone bodies; a simplified asset should need 16 or fewer"),
+			*GetNameSafe(GetOwner()), *HitZoneAsset->GetName(), Bodies.Num());
+	}
+}
+
+void UHurtboxComponent::AddBody(int32 BoneIndex, int32 ZoneIndex, const FVector& LocalStart, const FVector& LocalEnd, float Radius)
+{
+	FZoneBody& Body = Bodies.AddDefaulted_GetRef();
+	Body.BoneIndex = BoneIndex;
+	Body.ZoneIndex = ZoneIndex;
+	Body.LocalStart = LocalStart;
+	Body.LocalEnd = LocalEnd;
+	Body.Radius = Radius;
+	MinBodyRadius = Bodies.Num() == 1 ? Radius : FMath::Min(MinBodyRadius, Radius);
+}
+
+void UHurtboxComponent::PoseBodies(TArray<FPosedBody, TInlineAllocator<16>>& OutPosed) const
+{
+	OutPosed.Reset();
+	for (const FZoneBody& Body : Bodies)
+	{
+		const FTransform BoneTransform = Mesh->GetBoneTransform(Body.BoneIndex);
+		OutPosed.Add({ BoneTransform.TransformPosition(Body.LocalStart), BoneTransform.TransformPosition(Body.LocalEnd), Body.Radius });
+	}
+}
+
+void UHurtboxComponent::FillResult(int32 BodyIndex, const FVector& ImpactPoint, FHitZoneResult& OutResult) const
+{
+	const FZoneBody& Body = Bodies[BodyIndex];
+	OutResult.Bone = Mesh->GetBoneName(Body.BoneIndex);
+	OutResult.ImpactPoint = ImpactPoint;
+	if (HitZones.IsValidIndex(Body.ZoneIndex))
+	{
+		OutResult.Zone = HitZones[Body.ZoneIndex].Zone;
+		OutResult.DamageMultiplier = HitZones[Body.ZoneIndex].DamageMultiplier;
+	}
+	else
+	{
+		OutResult.Zone = EHitZone::Torso;
+		OutResult.DamageMultiplier = 1.f;
+	}
+}
+
+bool UHurtboxComponent::SweepHitZones(const FVector& PrevStart, const FVector& PrevEnd, const FVector& CurStart, const FVector& CurEnd, float Radius, FHitZoneResult& OutResult) const
+{
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseHurtboxNarrowphase);
+
+	if (!HasHitZones() || !Mesh)
+	{
+		return false;
+	}
+
+	TArray<FPosedBody, TInlineAllocator<16>> Posed;
+	PoseBodies(Posed);
+
+	const float Travel = FMath::Max(FVector::Dist(PrevStart, CurStart), FVector::Dist(PrevEnd, CurEnd));
+	const int32 NumSteps = FMath::Clamp(FMath::CeilToInt(Travel / FMath::Max(Radius + MinBodyRadius, 1.f)), 1, MaxNarrowphaseSteps);
+
+	for (int32 Step = 0; Step <= NumSteps; ++Step)
+	{
+		const float Alpha = static_cast<float>(Step) / NumSteps;
+		const FVector SegmentStart = FMath::Lerp(PrevStart, CurStart, Alpha);
+		const FVector SegmentEnd = FMath::Lerp(PrevEnd, CurEnd, Alpha);
+
+		// Deepest overlap at the first step that touches anything
+		int32 BestBody = INDEX_NONE;
+		float BestDepth = 0.f;
+		FVector BestPoint = FVector::ZeroVector;
+		for (int32 BodyIndex = 0; BodyIndex < Posed.Num(); ++BodyIndex)
+		{
+			const FPosedBody& Body = Posed[BodyIndex];
+			FVector OnSegment;
+			FVector OnBody;
+			FMath::SegmentDistToSegmentSafe(SegmentStart, SegmentEnd, Body.Start, Body.End, OnSegment, OnBody);
+			const float Depth = Radius + Body.Radius - FVector::Dist(OnSegment, OnBody);
+			if (Depth >= 0.f && (BestBody == INDEX_NONE || Depth > BestDepth))
+			{
+				BestBody = BodyIndex;
+				BestDepth = Depth;
+				BestPoint = OnBody + (OnSegment - OnBody).GetSafeNormal() * Body.Radius;
+			}
+		}
+
+		if (BestBody != INDEX_NONE)
+		{
+			FillResult(BestBody, BestPoint, OutResult);
+			return true;
+		}
+	}
+	return false;
+}
+
+void UHurtboxComponent::FindNearestZone(const FVector& Point, FHitZoneResult& OutResult) const
+{
+	OutResult = FHitZoneResult();
+	OutResult.ImpactPoint = Point;
+	if (!HasHitZones() || !Mesh)
+	{
+		return;
+	}
+
+	TArray<FPosedBody, TInlineAllocator<16>> Posed;
+	PoseBodies(Posed);
+
+	int32 BestBody = INDEX_NONE;
+	float BestDistance = 0.f;
+	for (int32 BodyIndex = 0; BodyIndex < Posed.Num(); ++BodyIndex)
+	{
+		const FPosedBody& Body = Posed[BodyIndex];
+		const float Distance = FVector::Dist(Point, FMath::ClosestPointOnSegment(Point, Body.Start, Body.End)) - Body.Radius;
+		if (BestBody == INDEX_NONE || Distance < BestDistance)
+		{
+			BestBody = BodyIndex;
+			BestDistance = Distance;
+		}
+	}
+	FillResult(BestBody, Point, OutResult);
+}
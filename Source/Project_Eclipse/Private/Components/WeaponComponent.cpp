@@ -0,0 +1,99 @@
+#include "Components/WeaponComponent.h"
+#include "Components/HitboxComponent.h"
+#include "Interfaces/Combatant.h"
+#include "Weapons/Weapon.h"
+#include "Engine/CollisionProfile.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+
+UWeaponComponent::UWeaponComponent()
+{
+	// Pure visuals: the blade is a hitbox shape, so there is nothing to tick, collide or overlap
+	PrimaryComponentTick.bCanEverTick = false;
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	SetGenerateOverlapEvents(false);
+	SetCanEverAffectNavigation(false);
+	CanCharacterStepUpOn = ECB_No;
+
+	// Nothing to show until a weapon is equipped
+	SetVisibility(false);
+}
+
+void UWeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetCollisionWindowEnabled(false);
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UWeaponComponent::Equip(TSubclassOf<AWeapon> InWeaponClass)
+{
+	LLM_SCOPE_BYTAG(Eclipse_Weapons);
+
+	SetCollisionWindowEnabled(false);
+
+	const AWeapon* Defaults = InWeaponClass ? InWeaponClass->GetDefaultObject<AWeapon>() : nullptr;
+	const UStaticMeshComponent* DefaultMesh = Defaults ? Defaults->GetSwordMesh() : nullptr;
+	if (!DefaultMesh)
+	{
+		Unequip();
+		return false;
+	}
+
+	WeaponClass = InWeaponClass;
+	SetStaticMesh(DefaultMesh->GetStaticMesh());
+	EmptyOverrideMaterials();
+	for (int32 MaterialIndex = 0; MaterialIndex < DefaultMesh->OverrideMaterials.Num(); ++MaterialIndex)
+	{
+		if (DefaultMesh->OverrideMaterials[MaterialIndex])
+		{
+			SetMaterial(MaterialIndex, DefaultMesh->OverrideMaterials[MaterialIndex]);
+		}
+	}
+
+	// The actor is snapped to the socket keeping its root's scale; the component sits at the socket the same way
+	SetRelativeTransform(FTransform(FQuat::Identity, FVector::ZeroVector, DefaultMesh->GetRelativeScale3D()));
+
+	Defaults->GetBladeLocalSegment(BladeStart, BladeEnd);
+	BladeRadius = Defaults->GetBladeHalfThickness();
+	Damage = Defaults->GetDamage();
+
+	SetVisibility(true);
+	return true;
+}
+
+void UWeaponComponent::Unequip()
+{
+	SetCollisionWindowEnabled(false);
+	SetVisibility(false);
+	WeaponClass = nullptr;
+}
+
+void UWeaponComponent::SetCollisionWindowEnabled(bool bOpen)
+{
+	if (bOpen == bCollisionWindowOpen || (bOpen && !IsEquipped()))
+	{
+		return;
+	}
+
+	const ICombatant* Combatant = ICombatant::Resolve(GetOwner());
+	UHitboxComponent* Hitboxes = Combatant ? Combatant->GetHitboxes() : nullptr;
+	if (Hitboxes)
+	{
+		// Same blade as AWeapon's Hitbox mode, so baked blade tracks and hit zones apply unchanged
+		if (bOpen)
+		{
+			Hitboxes->ActivateBlade(this, BladeStart, BladeEnd, BladeRadius, Damage, GetOwner());
+		}
+		else
+		{
+			Hitboxes->DeactivateBlade();
+		}
+	}
+	else if (bOpen)
+	{
+		return;
+	}
+
+	bCollisionWindowOpen = bOpen;
+	FEclipseLiveCounters::AddActiveWeaponWindows(bOpen ? 1 : -1);
+}
@@ -1,7 +1,168 @@
 #include "Core/MyGameMode.h"
 #include "HUD/MyHUD.h"
+#include "Enemy/Enemy.h"
+#include "Combat/CombatActorPoolSubsystem.h"
+#include "Combat/CombatAssetSubsystem.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+static float GEclipseSpawnBudgetMs = -1.f;
+static FAutoConsoleVariableRef CVarEclipseSpawnBudgetMs(
+    TEXT("Eclipse.Spawn.BudgetMs"),
+    GEclipseSpawnBudgetMs,
+    TEXT("Overrides AMyGameMode::SpawnBudgetMs, the game thread time per frame the encounter director spends spawning.\n")
+    TEXT("Negative: use the game mode's setting (default)"));
 
 AMyGameMode::AMyGameMode()
 {
+    // Returns straight away unless spawns are queued
+    PrimaryActorTick.bCanEverTick = true;
+
     HUDClass = AMyHUD::StaticClass();
-}
\ No newline at end of file
+}
+
+void AMyGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (DeferredEnemies.Num() > 0 || SpawnQueueHead < SpawnQueue.Num())
+    {
+        ProcessSpawnQueue();
+    }
+}
+
+void AMyGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Half-spawned enemies go back to the pool, or are destroyed
+    for (const FDeferredEnemy& Deferred : DeferredEnemies)
+    {
+        UCombatActorPoolSubsystem::Release(Deferred.Enemy.Get());
+    }
+    DeferredEnemies.Empty();
+    SpawnQueue.Empty();
+    SpawnQueueHead = 0;
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AMyGameMode::QueueEnemySpawn(const FEnemySpawnRequest& Request)
+{
+    if (!Request.EnemyClass)
+    {
+        UE_LOG(LogEclipse, Warning, TEXT("QueueEnemySpawn: No enemy class"));
+        return;
+    }
+
+    // Pre-encounter: the class's combat assets stream in while the request waits its turn
+    UCombatAssetSubsystem::PreloadCharacterClass(this, Request.EnemyClass);
+    SpawnQueue.Add(Request);
+}
+
+void AMyGameMode::QueueWave(const TArray<FEnemySpawnRequest>& Wave)
+{
+    SpawnQueue.Reserve(SpawnQueue.Num() + Wave.Num());
+    for (const FEnemySpawnRequest& Request : Wave)
+    {
+        QueueEnemySpawn(Request);
+    }
+}
+
+int32 AMyGameMode::GetNumPendingSpawns() const
+{
+    return SpawnQueue.Num() - SpawnQueueHead + DeferredEnemies.Num();
+}
+
+void AMyGameMode::ProcessSpawnQueue()
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseSpawnDirector);
+    ECLIPSE_PERF_BUDGET(SpawnDirector, 2500.0);
+    LLM_SCOPE_BYTAG(Eclipse_Enemies);
+
+    const double BudgetMs = GEclipseSpawnBudgetMs >= 0.f ? GEclipseSpawnBudgetMs : SpawnBudgetMs;
+    const double FrameStart = FPlatformTime::Seconds();
+    double StepStart = FrameStart;
+    bool bFirstStep = true;
+
+    // Whether a step expected to take StepMs still fits this frame; the first one always does
+    auto FitsBudget = [&](double StepMs)
+    {
+        return bFirstStep || (StepStart - FrameStart) * 1000.0 + StepMs <= BudgetMs;
+    };
+
+    // Ends a step, folding its time into the running average
+    auto EndStep = [&](double& AverageMs)
+    {
+        const double Now = FPlatformTime::Seconds();
+        AverageMs = FMath::Lerp(AverageMs, (Now - StepStart) * 1000.0, 0.2);
+        StepStart = Now;
+        bFirstStep = false;
+    };
+
+    // Enemies spawned on earlier frames finish first; the ones spawned below wait for the next frame
+    int32 NumFinished = 0;
+    while (NumFinished < DeferredEnemies.Num() && FitsBudget(AverageFinishMs))
+    {
+        const FDeferredEnemy Deferred = DeferredEnemies[NumFinished++];
+        FinishSpawn(Deferred);
+        EndStep(AverageFinishMs);
+    }
+    DeferredEnemies.RemoveAt(0, NumFinished, EAllowShrinking::No);
+
+    // In order; a request whose combat assets are still loading holds back the ones behind it
+    while (SpawnQueueHead < SpawnQueue.Num() && FitsBudget(AverageSpawnMs)
+        && UCombatAssetSubsystem::IsCharacterClassReady(this, SpawnQueue[SpawnQueueHead].EnemyClass))
+    {
+        SpawnDeferred(SpawnQueue[SpawnQueueHead++]);
+        EndStep(AverageSpawnMs);
+    }
+
+    if (SpawnQueueHead == SpawnQueue.Num())
+    {
+        SpawnQueue.Reset();
+        SpawnQueueHead = 0;
+    }
+}
+
+bool AMyGameMode::SpawnDeferred(const FEnemySpawnRequest& Request)
+{
+    AEnemy* Enemy = UCombatActorPoolSubsystem::AcquireDeferred<AEnemy>(this, Request.EnemyClass, Request.Transform);
+    if (!Enemy)
+    {
+        UE_LOG(LogEclipse, Error, TEXT("Encounter director: Failed to spawn %s"), *GetNameSafe(Request.EnemyClass));
+        OnEnemySpawnFailed(Request.Tag);
+        return false;
+    }
+
+    // Read by BeginPlay or the pool's reset, so set before the finish step: the enemy needs a controller and patrol target to equip its weapon
+    Enemy->AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+    Enemy->bEnableCombatAI = Request.bEnableCombatAI;
+    if (Request.PatrolTargets.Num() > 0 || Request.PatrolTarget)
+    {
+        Enemy->SetPatrolTargets(Request.PatrolTargets, Request.PatrolTarget);
+    }
+
+    FDeferredEnemy& Deferred = DeferredEnemies.AddDefaulted_GetRef();
+    Deferred.Enemy = Enemy;
+    Deferred.Transform = Request.Transform;
+    Deferred.Tag = Request.Tag;
+    return true;
+}
+
+void AMyGameMode::FinishSpawn(const FDeferredEnemy& Deferred)
+{
+    AEnemy* Enemy = Deferred.Enemy.Get();
+    if (!IsValid(Enemy))
+    {
+        UE_LOG(LogEclipse, Warning, TEXT("Encounter director: Deferred enemy was destroyed before it finished spawning"));
+        OnEnemySpawnFailed(Deferred.Tag);
+        return;
+    }
+
+    UCombatActorPoolSubsystem::FinishAcquire(Enemy, Deferred.Transform);
+    INC_DWORD_STAT(STAT_EclipseDirectorSpawns);
+    OnEnemySpawned(Enemy, Deferred.Tag);
+}
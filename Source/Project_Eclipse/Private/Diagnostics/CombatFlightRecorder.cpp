@@ -0,0 +1,286 @@
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+#include "UObject/Object.h"
+
+static int32 GEclipseFlightRecorderEnabled = 1;
+static FAutoConsoleVariableRef CVarEclipseFlightRecorderEnabled(
+	TEXT("Eclipse.FlightRecorder.Enable"),
+	GEclipseFlightRecorderEnabled,
+	TEXT("Record combat events (overlaps, traces, damage, hits, deaths, state changes) to Saved/FlightRecorder.\n")
+	TEXT("0: off, 1: on (default)"));
+
+static float GEclipseFlightRecorderWindowSeconds = 30.f;
+static FAutoConsoleVariableRef CVarEclipseFlightRecorderWindowSeconds(
+	TEXT("Eclipse.FlightRecorder.WindowSeconds"),
+	GEclipseFlightRecorderWindowSeconds,
+	TEXT("Seconds of history per flight record file. The previous file is kept, so at least this much is always on disk."));
+
+static float GEclipseFlightRecorderFlushSeconds = 0.25f;
+static FAutoConsoleVariableRef CVarEclipseFlightRecorderFlushSeconds(
+	TEXT("Eclipse.FlightRecorder.FlushSeconds"),
+	GEclipseFlightRecorderFlushSeconds,
+	TEXT("How often the writer thread drains the per-thread buffers to disk."));
+
+// Threads can exit after the recorder itself has been destroyed at process exit; their rings are gone by then
+static std::atomic<bool> GEclipseFlightRecorderRingsAlive{true};
+
+FCombatFlightRecorder& FCombatFlightRecorder::Get()
+{
+	static FCombatFlightRecorder Instance;
+	return Instance;
+}
+
+bool FCombatFlightRecorder::IsEnabled()
+{
+	return GEclipseFlightRecorderEnabled != 0;
+}
+
+void FCombatFlightRecorder::Record(ECombatEventType Type, const UObject* Source, const UObject* Target,
+	float Value, const FVector& Location, uint8 OldState, uint8 NewState)
+{
+	if (!GEclipseFlightRecorderEnabled)
+	{
+		return;
+	}
+
+	// Each thread owns one ring while it runs; registration takes a lock the first time only
+	thread_local FThreadRingLease ThreadRing;
+	if (!ThreadRing.Ring)
+	{
+		ThreadRing.Ring = Get().RegisterCurrentThread();
+		if (!ThreadRing.Ring)
+		{
+			return;
+		}
+	}
+
+	FCombatEventRecord NewRecord;
+	NewRecord.Cycles = FPlatformTime::Cycles64();
+	NewRecord.Frame = static_cast<uint32>(GFrameCounter);
+	NewRecord.SourceId = Source ? Source->GetUniqueID() : 0;
+	NewRecord.TargetId = Target ? Target->GetUniqueID() : 0;
+	NewRecord.Value = Value;
+	NewRecord.Location = FVector3f(Location);
+	NewRecord.Type = Type;
+	NewRecord.OldState = OldState;
+	NewRecord.NewState = NewState;
+
+	ThreadRing.Ring->Push(NewRecord);
+}
+
+FCombatFlightRecorder::FThreadRingLease::~FThreadRingLease()
+{
+	// Records still in the ring are drained as usual; the next thread to register carries on after them
+	if (Ring && GEclipseFlightRecorderRingsAlive.load(std::memory_order_acquire))
+	{
+		Ring->bInUse.store(false, std::memory_order_release);
+	}
+}
+
+void FCombatFlightRecorder::FThreadRing::Push(const FCombatEventRecord& InRecord)
+{
+	const uint64 CurrentHead = Head.load(std::memory_order_relaxed);
+	const uint64 CurrentTail = Tail.load(std::memory_order_acquire);
+	if (CurrentHead - CurrentTail >= RingCapacity)
+	{
+		// Writer fell behind; losing the newest event is better than stalling the game thread
+		Dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Records[CurrentHead % RingCapacity] = InRecord;
+	Head.store(CurrentHead + 1, std::memory_order_release);
+}
+
+void FCombatFlightRecorder::FThreadRing::Drain(TArray<FCombatEventRecord>& Out)
+{
+	const uint64 CurrentTail = Tail.load(std::memory_order_relaxed);
+	const uint64 CurrentHead = Head.load(std::memory_order_acquire);
+	for (uint64 Index = CurrentTail; Index < CurrentHead; ++Index)
+	{
+		Out.Add(Records[Index % RingCapacity]);
+	}
+	Tail.store(CurrentHead, std::memory_order_release);
+}
+
+FCombatFlightRecorder::~FCombatFlightRecorder()
+{
+	Shutdown();
+	GEclipseFlightRecorderRingsAlive.store(false, std::memory_order_release);
+}
+
+FCombatFlightRecorder::FThreadRing* FCombatFlightRecorder::RegisterCurrentThread()
+{
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+	FScopeLock Lock(&RingsLock);
+	if (bShutDown)
+	{
+		return nullptr;
+	}
+
+	// Reuse the ring of a thread that has exited; its release makes that thread's last pushes visible here
+	for (const TUniquePtr<FThreadRing>& Ring : Rings)
+	{
+		if (!Ring->bInUse.load(std::memory_order_acquire))
+		{
+			Ring->bInUse.store(true, std::memory_order_relaxed);
+			return Ring.Get();
+		}
+	}
+
+	FThreadRing* NewRing = Rings.Add_GetRef(MakeUnique<FThreadRing>()).Get();
+
+	// The writer starts with the first recorded event so editor and commandlet runs that never record anything leave no files behind
+	if (!Thread)
+	{
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+		Thread = FRunnableThread::Create(this, TEXT("EclipseFlightRecorder"), 0, TPri_BelowNormal);
+	}
+
+	return NewRing;
+}
+
+uint32 FCombatFlightRecorder::Run()
+{
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+
+	if (!OpenFile())
+	{
+		return 1;
+	}
+
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		WakeEvent->Wait(FTimespan::FromSeconds(FMath::Max(GEclipseFlightRecorderFlushSeconds, 0.01f)));
+		Flush();
+	}
+
+	Flush();
+	CloseFile();
+	return 0;
+}
+
+void FCombatFlightRecorder::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FCombatFlightRecorder::Shutdown()
+{
+	FRunnableThread* ThreadToStop = nullptr;
+	{
+		FScopeLock Lock(&RingsLock);
+		bShutDown = true;
+		ThreadToStop = Thread;
+		Thread = nullptr;
+	}
+
+	if (ThreadToStop)
+	{
+		// Kill(true) calls Stop() and waits for Run() to finish its final flush
+		ThreadToStop->Kill(true);
+		delete ThreadToStop;
+	}
+
+	if (WakeEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+	}
+}
+
+void FCombatFlightRecorder::Flush()
+{
+	DrainBuffer.Reset();
+	uint32 Dropped = 0;
+	{
+		FScopeLock Lock(&RingsLock);
+		for (const TUniquePtr<FThreadRing>& Ring : Rings)
+		{
+			Ring->Drain(DrainBuffer);
+			Dropped += Ring->Dropped.exchange(0, std::memory_order_relaxed);
+		}
+	}
+
+	if (Dropped > 0)
+	{
+		UE_LOG(LogEclipseCombat, Warning, TEXT("Flight recorder dropped %u events (ring full)"), Dropped);
+	}
+
+	if (DrainBuffer.Num() == 0 || !File)
+	{
+		return;
+	}
+
+	// Rings are per thread, so merge them back into time order
+	DrainBuffer.Sort([](const FCombatEventRecord& A, const FCombatEventRecord& B)
+	{
+		return A.Cycles < B.Cycles;
+	});
+
+	const double WindowSeconds = FMath::Max(GEclipseFlightRecorderWindowSeconds, 1.f);
+	if ((DrainBuffer[0].Cycles - FileStartCycles) * FPlatformTime::GetSecondsPerCycle64() > WindowSeconds)
+	{
+		RotateFile();
+		if (!File)
+		{
+			return;
+		}
+	}
+
+	File->Write(reinterpret_cast<const uint8*>(DrainBuffer.GetData()), DrainBuffer.Num() * sizeof(FCombatEventRecord));
+	File->Flush();
+}
+
+bool FCombatFlightRecorder::OpenFile()
+{
+	if (FilePath.IsEmpty())
+	{
+		const FString Directory = FPaths::ProjectSavedDir() / TEXT("FlightRecorder");
+		const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+		FilePath = Directory / FString::Printf(TEXT("Combat_%u.ecfr"), ProcessId);
+		PreviousFilePath = Directory / FString::Printf(TEXT("Combat_%u.prev.ecfr"), ProcessId);
+		FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Directory);
+	}
+
+	File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath);
+	if (!File)
+	{
+		UE_LOG(LogEclipseCombat, Error, TEXT("Flight recorder could not open %s"), *FilePath);
+		return false;
+	}
+
+	FCombatFlightRecordHeader Header;
+	Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	Header.StartCycles = FPlatformTime::Cycles64();
+	FileStartCycles = Header.StartCycles;
+	File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	return true;
+}
+
+void FCombatFlightRecorder::CloseFile()
+{
+	delete File;
+	File = nullptr;
+}
+
+void FCombatFlightRecorder::RotateFile()
+{
+	CloseFile();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.DeleteFile(*PreviousFilePath);
+	PlatformFile.MoveFile(*PreviousFilePath, *FilePath);
+
+	OpenFile();
+}
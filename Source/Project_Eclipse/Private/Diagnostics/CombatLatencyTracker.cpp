@@ -0,0 +1,222 @@
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLog.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+
+static FAutoConsoleCommand CmdEclipseLatencyReport(
+	TEXT("Eclipse.Latency.Report"),
+	TEXT("Log input-to-impact latency histograms per attack section."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatLatencyTracker::Get().LogReport();
+	}));
+
+static FAutoConsoleCommand CmdEclipseLatencyReset(
+	TEXT("Eclipse.Latency.Reset"),
+	TEXT("Clear the input-to-impact latency histograms."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCombatLatencyTracker::Get().Reset();
+	}));
+
+FCombatLatencyTracker& FCombatLatencyTracker::Get()
+{
+	static FCombatLatencyTracker Instance;
+	return Instance;
+}
+
+const TCHAR* FCombatLatencyTracker::GetStageName(ECombatLatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case ECombatLatencyStage::Input:		return TEXT("Input");
+	case ECombatLatencyStage::MontageStart:	return TEXT("MontageStart");
+	case ECombatLatencyStage::WeaponWindow:	return TEXT("WeaponWindow");
+	case ECombatLatencyStage::KickWindow:	return TEXT("KickWindow");
+	case ECombatLatencyStage::FirstContact:	return TEXT("FirstContact");
+	case ECombatLatencyStage::Damage:		return TEXT("Damage");
+	case ECombatLatencyStage::HealthBar:	return TEXT("HealthBar");
+	default:								return TEXT("Unknown");
+	}
+}
+
+void FCombatLatencyTracker::MarkInput(const AActor* Attacker)
+{
+	check(IsInGameThread());
+	if (Attacker)
+	{
+		PendingInputs.Add(Attacker->GetUniqueID(), { FPlatformTime::Seconds(), GFrameCounter });
+	}
+}
+
+void FCombatLatencyTracker::CancelInput(const AActor* Attacker)
+{
+	check(IsInGameThread());
+	if (Attacker)
+	{
+		PendingInputs.Remove(Attacker->GetUniqueID());
+	}
+}
+
+void FCombatLatencyTracker::BeginAttack(const AActor* Attacker, FName Section)
+{
+	check(IsInGameThread());
+	if (!Attacker)
+	{
+		return;
+	}
+
+	// A new swing closes out the previous one (combo chains never reach AttackEnd in between)
+	EndAttack(Attacker);
+
+	FAttackTimeline& Timeline = InFlight.Add(Attacker->GetUniqueID());
+	Timeline.Section = Section;
+
+	FInputStamp Input;
+	if (PendingInputs.RemoveAndCopyValue(Attacker->GetUniqueID(), Input))
+	{
+		const int32 InputIndex = static_cast<int32>(ECombatLatencyStage::Input);
+		Timeline.ReachedMask |= 1u << InputIndex;
+		Timeline.Seconds[InputIndex] = Input.Seconds;
+		Timeline.Frames[InputIndex] = Input.Frame;
+	}
+	else
+	{
+		Mark(Attacker, ECombatLatencyStage::Input);
+	}
+}
+
+void FCombatLatencyTracker::Mark(const AActor* Attacker, ECombatLatencyStage Stage)
+{
+	check(IsInGameThread());
+	FAttackTimeline* Timeline = Attacker ? InFlight.Find(Attacker->GetUniqueID()) : nullptr;
+	if (!Timeline)
+	{
+		return;
+	}
+
+	const int32 StageIndex = static_cast<int32>(Stage);
+	const uint32 StageBit = 1u << StageIndex;
+	if ((Timeline->ReachedMask & StageBit) == 0)
+	{
+		Timeline->ReachedMask |= StageBit;
+		Timeline->Seconds[StageIndex] = FPlatformTime::Seconds();
+		Timeline->Frames[StageIndex] = GFrameCounter;
+	}
+}
+
+void FCombatLatencyTracker::EndAttack(const AActor* Attacker)
+{
+	check(IsInGameThread());
+	FAttackTimeline Timeline;
+	if (Attacker && InFlight.RemoveAndCopyValue(Attacker->GetUniqueID(), Timeline))
+	{
+		Complete(Timeline);
+	}
+}
+
+void FCombatLatencyTracker::Complete(const FAttackTimeline& Timeline)
+{
+	const int32 InputIndex = static_cast<int32>(ECombatLatencyStage::Input);
+	FSectionStats& Stats = Sections.FindOrAdd(Timeline.Section);
+
+	for (int32 StageIndex = InputIndex + 1; StageIndex < static_cast<int32>(ECombatLatencyStage::Count); ++StageIndex)
+	{
+		if (Timeline.ReachedMask & (1u << StageIndex))
+		{
+			const double Ms = (Timeline.Seconds[StageIndex] - Timeline.Seconds[InputIndex]) * 1000.0;
+			const uint32 Frames = static_cast<uint32>(Timeline.Frames[StageIndex] - Timeline.Frames[InputIndex]);
+			Stats.Stages[StageIndex].Add(Ms, Frames);
+		}
+	}
+}
+
+void FCombatLatencyTracker::Reset()
+{
+	PendingInputs.Reset();
+	InFlight.Reset();
+	Sections.Reset();
+}
+
+void FCombatLatencyTracker::FHistogram::Add(double Ms, uint32 Frames)
+{
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt(Ms / BucketMs), 0, NumBuckets - 1);
+	++Buckets[Bucket];
+	++Count;
+	SumMs += Ms;
+	SumFrames += Frames;
+	MaxMs = FMath::Max(MaxMs, Ms);
+}
+
+double FCombatLatencyTracker::FHistogram::Percentile(double Percent) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	// Upper edge of the bucket holding the requested rank
+	const uint32 Rank = FMath::Max<uint32>(1, FMath::CeilToInt(Percent * Count));
+	uint32 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Rank)
+		{
+			return FMath::Min((Bucket + 1) * BucketMs, MaxMs);
+		}
+	}
+	return MaxMs;
+}
+
+void FCombatLatencyTracker::LogReport() const
+{
+	for (const TPair<FName, FSectionStats>& Section : Sections)
+	{
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ECombatLatencyStage::Count); ++StageIndex)
+		{
+			const FHistogram& Histogram = Section.Value.Stages[StageIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			UE_LOG(LogEclipse, Display, TEXT("Latency %s -> %s: %u attacks, mean %.1f ms (%.1f frames), p50 %.0f ms, p95 %.0f ms, max %.1f ms"),
+				*Section.Key.ToString(), GetStageName(static_cast<ECombatLatencyStage>(StageIndex)), Histogram.Count,
+				Histogram.SumMs / Histogram.Count, static_cast<double>(Histogram.SumFrames) / Histogram.Count,
+				Histogram.Percentile(0.5), Histogram.Percentile(0.95), Histogram.MaxMs);
+		}
+	}
+}
+
+bool FCombatLatencyTracker::AppendCsv(const FString& FilePath, const FString& RunLabel) const
+{
+	FString Csv;
+	if (!IFileManager::Get().FileExists(*FilePath))
+	{
+		Csv = TEXT("Timestamp,Run,Section,Stage,Attacks,MeanMs,MeanFrames,P50Ms,P95Ms,MaxMs\n");
+	}
+
+	const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+	for (const TPair<FName, FSectionStats>& Section : Sections)
+	{
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ECombatLatencyStage::Count); ++StageIndex)
+		{
+			const FHistogram& Histogram = Section.Value.Stages[StageIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			Csv += FString::Printf(TEXT("%s,%s,%s,%s,%u,%.3f,%.2f,%.1f,%.1f,%.3f\n"),
+				*Timestamp, *RunLabel, *Section.Key.ToString(), GetStageName(static_cast<ECombatLatencyStage>(StageIndex)),
+				Histogram.Count, Histogram.SumMs / Histogram.Count, static_cast<double>(Histogram.SumFrames) / Histogram.Count,
+				Histogram.Percentile(0.5), Histogram.Percentile(0.95), Histogram.MaxMs);
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
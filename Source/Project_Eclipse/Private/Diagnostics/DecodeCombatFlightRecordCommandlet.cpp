@@ -0,0 +1,107 @@
+#include "Diagnostics/DecodeCombatFlightRecordCommandlet.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Characters/CharacterTypes.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	const TCHAR* EventTypeName(ECombatEventType Type)
+	{
+		switch (Type)
+		{
+		case ECombatEventType::WeaponOverlap:		return TEXT("WeaponOverlap");
+		case ECombatEventType::BoxTrace:			return TEXT("BoxTrace");
+		case ECombatEventType::ApplyDamage:			return TEXT("ApplyDamage");
+		case ECombatEventType::GetHit:				return TEXT("GetHit");
+		case ECombatEventType::Die:					return TEXT("Die");
+		case ECombatEventType::EnemyStateChange:	return TEXT("EnemyStateChange");
+		case ECombatEventType::ActionStateChange:	return TEXT("ActionStateChange");
+		default:									return TEXT("Unknown");
+		}
+	}
+
+	FString StateName(ECombatEventType Type, uint8 State)
+	{
+		if (Type == ECombatEventType::EnemyStateChange)
+		{
+			return StaticEnum<EEnemyState>()->GetNameStringByValue(State);
+		}
+		// Player and enemy action states share values: 0 = unoccupied, 1 = attacking
+		return State == 0 ? TEXT("Unoccupied") : State == 1 ? TEXT("Attacking") : FString::FromInt(State);
+	}
+}
+
+UDecodeCombatFlightRecordCommandlet::UDecodeCombatFlightRecordCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UDecodeCombatFlightRecordCommandlet::Main(const FString& Params)
+{
+	FString InputPath;
+	if (!FParse::Value(*Params, TEXT("File="), InputPath))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("Usage: -run=DecodeCombatFlightRecord -File=<path.ecfr> [-Out=<path.csv>]"));
+		return 1;
+	}
+
+	FString OutputPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutputPath))
+	{
+		OutputPath = FPaths::ChangeExtension(InputPath, TEXT("csv"));
+	}
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InputPath))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("Could not read %s"), *InputPath);
+		return 1;
+	}
+
+	FCombatFlightRecordHeader Header;
+	if (Bytes.Num() < sizeof(Header))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("%s is too small to be a flight record"), *InputPath);
+		return 1;
+	}
+	FMemory::Memcpy(&Header, Bytes.GetData(), sizeof(Header));
+
+	if (Header.Magic != FCombatFlightRecordHeader::ExpectedMagic || Header.Version != FCombatFlightRecordHeader::CurrentVersion
+		|| Header.RecordSize != sizeof(FCombatEventRecord))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("%s is not a version %u flight record"), *InputPath, FCombatFlightRecordHeader::CurrentVersion);
+		return 1;
+	}
+
+	// A crash can leave a partial record at the end; ignore it
+	const int32 NumRecords = (Bytes.Num() - sizeof(Header)) / sizeof(FCombatEventRecord);
+	const FCombatEventRecord* Records = reinterpret_cast<const FCombatEventRecord*>(Bytes.GetData() + sizeof(Header));
+
+	FString Csv = TEXT("Seconds,Frame,Event,Source,Target,Value,X,Y,Z,OldState,NewState\n");
+	for (int32 Index = 0; Index < NumRecords; ++Index)
+	{
+		const FCombatEventRecord& Record = Records[Index];
+		const double Seconds = (static_cast<int64>(Record.Cycles) - static_cast<int64>(Header.StartCycles)) * Header.SecondsPerCycle;
+		const bool bStateChange = Record.Type == ECombatEventType::EnemyStateChange || Record.Type == ECombatEventType::ActionStateChange;
+
+		Csv += FString::Printf(TEXT("%.6f,%u,%s,%u,%u,%.3f,%.1f,%.1f,%.1f,%s,%s\n"),
+			Seconds, Record.Frame, EventTypeName(Record.Type), Record.SourceId, Record.TargetId, Record.Value,
+			Record.Location.X, Record.Location.Y, Record.Location.Z,
+			bStateChange ? *StateName(Record.Type, Record.OldState) : TEXT(""),
+			bStateChange ? *StateName(Record.Type, Record.NewState) : TEXT(""));
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("Could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogEclipse, Display, TEXT("Decoded %d combat events to %s"), NumRecords, *OutputPath);
+	return 0;
+}
@@ -0,0 +1,170 @@
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/EclipseLog.h"
+#include "HAL/MemoryBase.h"
+
+DEFINE_STAT(STAT_EclipseAllocs_EnemyChoosePatrolTarget);
+DEFINE_STAT(STAT_EclipseAllocs_WeaponBoxTrace);
+DEFINE_STAT(STAT_EclipseAllocs_WeaponOverlapQuery);
+DEFINE_STAT(STAT_EclipseAllocs_WeaponSweepBlade);
+DEFINE_STAT(STAT_EclipseAllocs_HitboxQuery);
+
+#if ECLIPSE_WITH_ALLOC_TRACKING
+
+namespace
+{
+	// Counted per thread so a scope only sees its own allocations
+	thread_local uint64 GThreadAllocationCount = 0;
+
+	class FEclipseCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FEclipseCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			++GThreadAllocationCount;
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			++GThreadAllocationCount;
+			return Inner->TryMalloc(Size, Alignment);
+		}
+
+		virtual void* MallocZeroed(SIZE_T Size, uint32 Alignment) override
+		{
+			++GThreadAllocationCount;
+			return Inner->MallocZeroed(Size, Alignment);
+		}
+
+		virtual void* TryMallocZeroed(SIZE_T Size, uint32 Alignment) override
+		{
+			++GThreadAllocationCount;
+			return Inner->TryMallocZeroed(Size, Alignment);
+		}
+
+		// Growing a container is the churn we are looking for, so reallocations count too
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size != 0)
+			{
+				++GThreadAllocationCount;
+			}
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size != 0)
+			{
+				++GThreadAllocationCount;
+			}
+			return Inner->TryRealloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		FMalloc* Inner;
+	};
+
+	struct FAllocScopeRegistry
+	{
+		FCriticalSection Lock;
+		TArray<FEclipseAllocScopeCounter*> Counters;
+
+		static FAllocScopeRegistry& Get()
+		{
+			static FAllocScopeRegistry Instance;
+			return Instance;
+		}
+	};
+}
+
+bool FEclipseAllocTracking::bInstalled = false;
+
+FEclipseAllocScopeCounter::FEclipseAllocScopeCounter(const TCHAR* InName)
+	: Name(InName)
+{
+	FEclipseAllocTracking::Register(*this);
+}
+
+void FEclipseAllocTracking::Install()
+{
+	check(IsInGameThread());
+	if (bInstalled)
+	{
+		return;
+	}
+
+	// Memory allocated before this point is freed through the proxy, which forwards to the same allocator
+	GMalloc = new FEclipseCountingMalloc(GMalloc);
+	bInstalled = true;
+
+	UE_LOG(LogEclipse, Display, TEXT("AllocTracking: Counting allocations in ECLIPSE_ALLOC_SCOPE scopes"));
+}
+
+uint64 FEclipseAllocTracking::GetThreadAllocationCount()
+{
+	return GThreadAllocationCount;
+}
+
+void FEclipseAllocTracking::Register(FEclipseAllocScopeCounter& Counter)
+{
+	FAllocScopeRegistry& Registry = FAllocScopeRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.Counters.Add(&Counter);
+}
+
+void FEclipseAllocTracking::BeginWindow()
+{
+	FAllocScopeRegistry& Registry = FAllocScopeRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	for (FEclipseAllocScopeCounter* Counter : Registry.Counters)
+	{
+		Counter->Allocations.store(0, std::memory_order_relaxed);
+		Counter->Calls.store(0, std::memory_order_relaxed);
+	}
+}
+
+int32 FEclipseAllocTracking::CheckNoAllocations()
+{
+	FAllocScopeRegistry& Registry = FAllocScopeRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	int32 Violations = 0;
+	for (const FEclipseAllocScopeCounter* Counter : Registry.Counters)
+	{
+		const uint64 Allocations = Counter->Allocations.load(std::memory_order_relaxed);
+		const uint64 Calls = Counter->Calls.load(std::memory_order_relaxed);
+		if (Allocations > 0)
+		{
+			++Violations;
+			UE_LOG(LogEclipse, Error, TEXT("AllocTracking: %s allocated %llu times in %llu calls after warmup"), Counter->Name, Allocations, Calls);
+		}
+		else
+		{
+			UE_LOG(LogEclipse, Display, TEXT("AllocTracking: %s allocation free (%llu calls)"), Counter->Name, Calls);
+		}
+	}
+	return Violations;
+}
+
+#endif
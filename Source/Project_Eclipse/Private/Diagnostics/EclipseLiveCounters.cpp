@@ -0,0 +1,168 @@
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Diagnostics/EclipseLog.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+
+namespace
+{
+	std::atomic<int32> GLiveEnemies{0};
+	std::atomic<int32> GActiveWeaponWindows{0};
+	std::atomic<uint32> GPooledInUse{0};
+	std::atomic<uint32> GPooledCapacity{0};
+
+	std::atomic<uint32> GTracesThisFrame{0};
+	std::atomic<uint32> GOverlapsThisFrame{0};
+	std::atomic<uint32> GDamageEventsThisFrame{0};
+
+	FPlatformMemory::FSharedMemoryRegion* GRegion = nullptr;
+	FDelegateHandle GEndFrameHandle;
+
+	// Damage rate window
+	double GDamageWindowStart = 0.0;
+	uint32 GDamageEventsInWindow = 0;
+	double GDamageEventsPerSecond = 0.0;
+}
+
+FString FEclipseLiveCounters::GetRegionName(uint32 ProcessId)
+{
+	return FString::Printf(TEXT("%s%u"), TEXT(ECLIPSE_LIVE_COUNTERS_REGION_PREFIX), ProcessId);
+}
+
+bool FEclipseLiveCounters::Start()
+{
+	check(IsInGameThread());
+	if (GRegion)
+	{
+		return true;
+	}
+
+	const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+	const FString RegionName = GetRegionName(ProcessId);
+	GRegion = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true,
+		FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, sizeof(FEclipseLiveCounterBlock));
+	if (!GRegion)
+	{
+		UE_LOG(LogEclipse, Error, TEXT("Live counters: could not create shared memory region %s"), *RegionName);
+		return false;
+	}
+
+	FEclipseLiveCounterBlock* Block = static_cast<FEclipseLiveCounterBlock*>(GRegion->GetAddress());
+	FMemory::Memzero(Block, sizeof(FEclipseLiveCounterBlock));
+	Block->Magic = FEclipseLiveCounterBlock::ExpectedMagic;
+	Block->Version = FEclipseLiveCounterBlock::CurrentVersion;
+	Block->Size = sizeof(FEclipseLiveCounterBlock);
+	Block->ProcessId = ProcessId;
+
+	GDamageWindowStart = FPlatformTime::Seconds();
+	GEndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FEclipseLiveCounters::Publish);
+
+	UE_LOG(LogEclipse, Display, TEXT("Live counters: publishing to %s"), *RegionName);
+	return true;
+}
+
+void FEclipseLiveCounters::Stop()
+{
+	if (!GRegion)
+	{
+		return;
+	}
+
+	FCoreDelegates::OnEndFrame.Remove(GEndFrameHandle);
+	GEndFrameHandle.Reset();
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(GRegion);
+	GRegion = nullptr;
+}
+
+bool FEclipseLiveCounters::IsRunning()
+{
+	return GRegion != nullptr;
+}
+
+void FEclipseLiveCounters::AddLiveEnemies(int32 Delta)
+{
+	GLiveEnemies.fetch_add(Delta, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::AddActiveWeaponWindows(int32 Delta)
+{
+	GActiveWeaponWindows.fetch_add(Delta, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::SetPoolOccupancy(uint32 InUse, uint32 Capacity)
+{
+	GPooledInUse.store(InUse, std::memory_order_relaxed);
+	GPooledCapacity.store(Capacity, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::CountTrace()
+{
+	GTracesThisFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::CountOverlap()
+{
+	GOverlapsThisFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::CountDamageEvent()
+{
+	GDamageEventsThisFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FEclipseLiveCounters::Publish()
+{
+	if (!GRegion)
+	{
+		return;
+	}
+
+	const uint32 Traces = GTracesThisFrame.exchange(0, std::memory_order_relaxed);
+	const uint32 Overlaps = GOverlapsThisFrame.exchange(0, std::memory_order_relaxed);
+	const uint32 DamageEvents = GDamageEventsThisFrame.exchange(0, std::memory_order_relaxed);
+
+	const double Now = FPlatformTime::Seconds();
+	GDamageEventsInWindow += DamageEvents;
+	if (Now - GDamageWindowStart >= 1.0)
+	{
+		GDamageEventsPerSecond = GDamageEventsInWindow / (Now - GDamageWindowStart);
+		GDamageEventsInWindow = 0;
+		GDamageWindowStart = Now;
+	}
+
+	FEclipseLiveCounterBlock* Block = static_cast<FEclipseLiveCounterBlock*>(GRegion->GetAddress());
+
+	// Seqlock write: odd while the fields are inconsistent
+	const uint32 Sequence = Block->Sequence.load(std::memory_order_relaxed);
+	Block->Sequence.store(Sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	Block->Frame = GFrameCounter;
+	Block->FrameTimeMs = FApp::GetDeltaTime() * 1000.0;
+	Block->GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Block->DamageEventsPerSecond = GDamageEventsPerSecond;
+	Block->LiveEnemies = static_cast<uint32>(FMath::Max(GLiveEnemies.load(std::memory_order_relaxed), 0));
+	Block->ActiveWeaponWindows = static_cast<uint32>(FMath::Max(GActiveWeaponWindows.load(std::memory_order_relaxed), 0));
+	Block->TracesPerFrame = Traces;
+	Block->OverlapsPerFrame = Overlaps;
+	Block->DamageEventsPerFrame = DamageEvents;
+	Block->PooledInUse = GPooledInUse.load(std::memory_order_relaxed);
+	Block->PooledCapacity = GPooledCapacity.load(std::memory_order_relaxed);
+
+	Block->Sequence.store(Sequence + 2, std::memory_order_release);
+}
+
+bool FEclipseLiveCounters::ReadSnapshot(uint32 ProcessId, FEclipseLiveCounterBlock& OutBlock)
+{
+	FPlatformMemory::FSharedMemoryRegion* ReadRegion = FPlatformMemory::MapNamedSharedMemoryRegion(GetRegionName(ProcessId), false,
+		FPlatformMemory::ESharedMemoryAccess::Read, sizeof(FEclipseLiveCounterBlock));
+	if (!ReadRegion)
+	{
+		return false;
+	}
+
+	const FEclipseLiveCounterBlock* Block = static_cast<const FEclipseLiveCounterBlock*>(ReadRegion->GetAddress());
+	const bool bRead = Block->Magic == FEclipseLiveCounterBlock::ExpectedMagic && TryReadEclipseLiveCounters(*Block, OutBlock);
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(ReadRegion);
+	return bRead;
+}
@@ -0,0 +1,19 @@
+#include "Diagnostics/EclipseLog.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogEclipse);
+DEFINE_LOG_CATEGORY(LogEclipseCombat);
+DEFINE_LOG_CATEGORY(LogEclipseAI);
+DEFINE_LOG_CATEGORY(LogEclipseHUD);
+
+#if ECLIPSE_WITH_DEBUG_LOGGING
+
+int32 GEclipseScreenMessages = 0;
+static FAutoConsoleVariableRef CVarEclipseScreenMessages(
+	TEXT("Eclipse.Debug.ScreenMessages"),
+	GEclipseScreenMessages,
+	TEXT("Show combat debug messages on screen (weapon windows, weapon ownership).\n")
+	TEXT("0: off (default), 1: on"),
+	ECVF_Cheat);
+
+#endif
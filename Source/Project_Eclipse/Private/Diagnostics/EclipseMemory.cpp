@@ -0,0 +1,8 @@
+#include "Diagnostics/EclipseMemory.h"
+
+LLM_DEFINE_TAG(Eclipse);
+LLM_DEFINE_TAG(Eclipse_Enemies, TEXT("Enemies"), TEXT("Eclipse"));
+LLM_DEFINE_TAG(Eclipse_Weapons, TEXT("Weapons"), TEXT("Eclipse"));
+LLM_DEFINE_TAG(Eclipse_HUD, TEXT("HUD"), TEXT("Eclipse"));
+LLM_DEFINE_TAG(Eclipse_AI, TEXT("AI"), TEXT("Eclipse"));
+LLM_DEFINE_TAG(Eclipse_Combat, TEXT("Combat"), TEXT("Eclipse"));
@@ -0,0 +1,158 @@
+#include "Diagnostics/EclipsePerfBudget.h"
+
+#if ECLIPSE_WITH_PERF_BUDGETS
+
+#include "Diagnostics/EclipseLog.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+bool FEclipsePerfBudgets::bEnabled = false;
+
+static FAutoConsoleCommand CmdEclipsePerfBudgetsEnable(
+	TEXT("Eclipse.PerfBudgets.Enable"),
+	TEXT("Start (1) or stop (0) timing ECLIPSE_PERF_BUDGET scopes. Starting opens a new sample window."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FEclipsePerfBudgets::SetEnabled(Args.Num() == 0 || Args[0] != TEXT("0"));
+	}));
+
+static FAutoConsoleCommand CmdEclipsePerfBudgetsReport(
+	TEXT("Eclipse.PerfBudgets.Report"),
+	TEXT("Log the mean cost of every ECLIPSE_PERF_BUDGET scope in the current window against its budget."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FEclipsePerfBudgets::CheckBudgets(1);
+	}));
+
+namespace
+{
+	struct FBudgetRegistry
+	{
+		FCriticalSection Lock;
+		TArray<FEclipsePerfBudget*> Budgets;
+		TMap<FString, double> Overrides;
+		bool bOverridesLoaded = false;
+
+		static FBudgetRegistry& Get()
+		{
+			static FBudgetRegistry Instance;
+			return Instance;
+		}
+
+		// Config/EclipsePerfBudgets.json: { "Budgets": { "WeaponOnBoxOverlap": 60, ... } } in microseconds
+		void LoadOverrides()
+		{
+			bOverridesLoaded = true;
+
+			const FString FilePath = FPaths::ProjectConfigDir() / TEXT("EclipsePerfBudgets.json");
+			FString JsonText;
+			if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+			{
+				UE_LOG(LogEclipse, Verbose, TEXT("PerfBudgets: %s not found, using defaults from code"), *FilePath);
+				return;
+			}
+
+			TSharedPtr<FJsonObject> Root;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+			if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+			{
+				UE_LOG(LogEclipse, Error, TEXT("PerfBudgets: Could not parse %s"), *FilePath);
+				return;
+			}
+
+			const TSharedPtr<FJsonObject>* BudgetsObject = nullptr;
+			if (Root->TryGetObjectField(TEXT("Budgets"), BudgetsObject))
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*BudgetsObject)->Values)
+				{
+					double Microseconds = 0.0;
+					if (Entry.Value.IsValid() && Entry.Value->TryGetNumber(Microseconds))
+					{
+						Overrides.Add(Entry.Key, Microseconds);
+					}
+				}
+			}
+		}
+	};
+}
+
+FEclipsePerfBudget::FEclipsePerfBudget(const TCHAR* InName, double InDefaultMicroseconds)
+	: Name(InName)
+	, BudgetMicroseconds(InDefaultMicroseconds)
+{
+	FEclipsePerfBudgets::Register(*this);
+}
+
+void FEclipsePerfBudgets::Register(FEclipsePerfBudget& Budget)
+{
+	FBudgetRegistry& Registry = FBudgetRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	if (!Registry.bOverridesLoaded)
+	{
+		Registry.LoadOverrides();
+	}
+
+	if (const double* Override = Registry.Overrides.Find(Budget.Name))
+	{
+		Budget.BudgetMicroseconds = *Override;
+	}
+	Registry.Budgets.Add(&Budget);
+}
+
+void FEclipsePerfBudgets::SetEnabled(bool bInEnabled)
+{
+	if (bInEnabled && !bEnabled)
+	{
+		BeginWindow();
+	}
+	bEnabled = bInEnabled;
+}
+
+void FEclipsePerfBudgets::BeginWindow()
+{
+	FBudgetRegistry& Registry = FBudgetRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	for (FEclipsePerfBudget* Budget : Registry.Budgets)
+	{
+		Budget->TotalCycles.store(0, std::memory_order_relaxed);
+		Budget->Samples.store(0, std::memory_order_relaxed);
+	}
+}
+
+int32 FEclipsePerfBudgets::CheckBudgets(int32 MinSamples)
+{
+	FBudgetRegistry& Registry = FBudgetRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+
+	int32 Violations = 0;
+	for (const FEclipsePerfBudget* Budget : Registry.Budgets)
+	{
+		const uint64 Samples = Budget->Samples.load(std::memory_order_relaxed);
+		if (Samples == 0 || Samples < static_cast<uint64>(MinSamples))
+		{
+			continue;
+		}
+
+		const double MeanMicroseconds = FPlatformTime::ToSeconds64(Budget->TotalCycles.load(std::memory_order_relaxed)) * 1000000.0 / Samples;
+		if (MeanMicroseconds > Budget->BudgetMicroseconds)
+		{
+			++Violations;
+			UE_LOG(LogEclipse, Error, TEXT("PerfBudgets: %s over budget: mean %.2f us > %.2f us (%llu samples)"),
+				Budget->Name, MeanMicroseconds, Budget->BudgetMicroseconds, Samples);
+		}
+		else
+		{
+			UE_LOG(LogEclipse, Display, TEXT("PerfBudgets: %s mean %.2f us / %.2f us (%llu samples)"),
+				Budget->Name, MeanMicroseconds, Budget->BudgetMicroseconds, Samples);
+		}
+	}
+	return Violations;
+}
+
+#endif
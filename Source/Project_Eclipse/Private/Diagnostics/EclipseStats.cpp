@@ -0,0 +1,42 @@
+#include "Diagnostics/EclipseStats.h"
+
+DEFINE_STAT(STAT_EclipseWeaponOnBoxOverlap);
+DEFINE_STAT(STAT_EclipseWeaponBoxTrace);
+DEFINE_STAT(STAT_EclipseWeaponSweepBlade);
+DEFINE_STAT(STAT_EclipseWeaponAsyncTraceDone);
+DEFINE_STAT(STAT_EclipseWeaponGatherAttached);
+
+DEFINE_STAT(STAT_EclipseCombatResolve);
+
+DEFINE_STAT(STAT_EclipsePoolAcquire);
+DEFINE_STAT(STAT_EclipsePoolRelease);
+
+DEFINE_STAT(STAT_EclipseSpawnDirector);
+
+DEFINE_STAT(STAT_EclipseAssetPrewarm);
+
+DEFINE_STAT(STAT_EclipseHitEffects);
+
+DEFINE_STAT(STAT_EclipseDirectionalHitReact);
+DEFINE_STAT(STAT_EclipseHitboxQuery);
+DEFINE_STAT(STAT_EclipseHurtboxNarrowphase);
+
+DEFINE_STAT(STAT_EclipseEnemyTick);
+DEFINE_STAT(STAT_EclipseEnemyMoveToTarget);
+DEFINE_STAT(STAT_EclipseEnemyInTargetRange);
+DEFINE_STAT(STAT_EclipseEnemyAnimUpdate);
+
+DEFINE_STAT(STAT_EclipseHUDSetTargetedEnemy);
+DEFINE_STAT(STAT_EclipseHUDClearTargetedEnemy);
+
+DEFINE_STAT(STAT_EclipseTraces);
+DEFINE_STAT(STAT_EclipseOverlaps);
+DEFINE_STAT(STAT_EclipseDamageApplications);
+DEFINE_STAT(STAT_EclipseMontagePlays);
+DEFINE_STAT(STAT_EclipsePoolSpawns);
+DEFINE_STAT(STAT_EclipseDirectorSpawns);
+DEFINE_STAT(STAT_EclipseEffectsSpawned);
+DEFINE_STAT(STAT_EclipseEffectsMerged);
+DEFINE_STAT(STAT_EclipseEffectsCulled);
+
+UE_TRACE_CHANNEL_DEFINE(EclipseChannel);
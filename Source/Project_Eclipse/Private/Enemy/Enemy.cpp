@@ -4,6 +4,7 @@
 #include "DrawDebugHelpers.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/WeaponComponent.h"
 #include "HUD/HealthBarComponent.h"
 #include "HUD/MainHUD.h"
 #include "HUD/Character_Overlay.h"
@@ -14,51 +15,37 @@
 #include "Kismet/GameplayStatics.h"
 #include "Weapons/Weapon.h"
 #include "Engine/Engine.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Replay/CombatReplaySubsystem.h"
+#include "Combat/CombatActorPoolSubsystem.h"
+#include "Combat/CombatEffectsSubsystem.h"
+#include "Combat/CombatAssetSet.h"
 
 
 
 
 AEnemy::AEnemy()
 {
+	LLM_SCOPE_BYTAG(Eclipse_Enemies);
+
 	PrimaryActorTick.bCanEverTick = true;
 	
-	// Set up mesh collision - optimized to prevent self-collision issues
-	if (GetMesh())
-	{
-		GetMesh()->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-		GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
-		GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-		// Changed from ECR_Block to ECR_Ignore for pawns to prevent self-collision with weapon
-		GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
-		GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Block);
-		GetMesh()->SetGenerateOverlapEvents(false); // Disable overlap events on mesh to prevent self-hits
-		GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		UE_LOG(LogTemp, Warning, TEXT("Enemy: Mesh collision setup complete (optimized for weapon system)"));
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Enemy: Mesh is null during construction"));
-	}
+	// The capsule is the CombatHurtbox and the mesh has no collision, both set up by ABaseCharacter
 
-	// Set up capsule collision
-	if (GetCapsuleComponent())
-	{
-		GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-		GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Block);
-		GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Block);
-		GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		GetCapsuleComponent()->SetCollisionObjectType(ECollisionChannel::ECC_Pawn);
-		UE_LOG(LogTemp, Warning, TEXT("Enemy: Capsule collision setup complete"));
-	}
-	else
+	// Create and set up health bar widget
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Enemy: Capsule component is null during construction"));
+		LLM_SCOPE_BYTAG(Eclipse_HUD);
+		HealthBarWidget1 = CreateDefaultSubobject<UHealthBarComponent>(TEXT("HealthBarWidget1"));
+		HealthBarWidget1->SetupAttachment(GetRootComponent());
 	}
 
-	// Create and set up health bar widget
-	HealthBarWidget1 = CreateDefaultSubobject<UHealthBarComponent>(TEXT("HealthBarWidget1"));
-	HealthBarWidget1->SetupAttachment(GetRootComponent());
-
 	// Set up character movement - optimized to prevent animation conflicts
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	GetCharacterMovement()->bUseControllerDesiredRotation = false;
@@ -73,17 +60,25 @@ AEnemy::AEnemy()
 	bUseControllerRotationRoll = false;
 
 	// Create AI perception component
-	AIPerception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerception"));
+	{
+		LLM_SCOPE_BYTAG(Eclipse_AI);
+		AIPerception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerception"));
+	}
 
-	// Initialize weapon as null - will be spawned in BeginPlay
+	// Initialize weapon as null - will be equipped in BeginPlay
 	EquippedWeapon = nullptr;
+
+	// Enemies never drop or swap weapons, so theirs lives on the character instead of in an actor of its own
+	bWeaponAsComponent = true;
 }
 
 void AEnemy::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Eclipse_Enemies);
+
 	Super::BeginPlay();
 
-	UE_LOG(LogTemp, Warning, TEXT("Enemy BeginPlay started"));
+	ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("Enemy BeginPlay started"));
 
     if (bDisableAllCollision)
     {
@@ -98,94 +93,77 @@ void AEnemy::BeginPlay()
         {
             SkeletalMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
         }
-        UE_LOG(LogTemp, Warning, TEXT("Enemy: All collisions disabled (debug)"));
+        ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy: All collisions disabled (debug)"));
     }
 
+	// Parked until the pool hands it out
+	if (bPooledInstance)
+	{
+		bIsDead = true;
+		return;
+	}
+
+	FEclipseLiveCounters::AddLiveEnemies(1);
+	StartEnemy();
+}
+
+void AEnemy::StartEnemy()
+{
+	RandomStream.Initialize(UCombatReplaySubsystem::MakeActorSeed(this));
+
 	if (HealthBarWidget1)
 	{
 		HealthBarWidget1->SetHealthPercent(1.f);
-		UE_LOG(LogTemp, Warning, TEXT("Health bar widget initialized"));
+		ECLIPSE_LOG(LogEclipseHUD, Verbose, TEXT("Health bar widget initialized"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Health bar widget is null"));
+		ECLIPSE_LOG(LogEclipseHUD, Warning, TEXT("Health bar widget is null"));
 	}
 
 	EnemyController = Cast<AAIController>(GetController());
 	if (!EnemyController)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Enemy controller is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("Enemy controller is null"));
 		return;
 	}
 
 	if (!PatrolTarget)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Patrol target is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("Patrol target is null"));
 		return;
 	}
 
 	// Initialize patrol state
-	EnemyState = EEnemyState::EES_Patrolling;
+	SetEnemyState(EEnemyState::EES_Patrolling);
 	GetCharacterMovement()->MaxWalkSpeed = 300.f;
 
 	// Set up AI perception
 	if (AIPerception)
 	{
-		AIPerception->OnPerceptionUpdated.AddDynamic(this, &AEnemy::OnPerceptionUpdated);
-		UE_LOG(LogTemp, Warning, TEXT("AI perception initialized"));
+		LLM_SCOPE_BYTAG(Eclipse_AI);
+		AIPerception->OnPerceptionUpdated.AddUniqueDynamic(this, &AEnemy::OnPerceptionUpdated);
+		ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("AI perception initialized"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AI perception is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("AI perception is null"));
 	}
 
-	// Spawn and equip weapon
-	if (WeaponClass)
-	{
-		EquippedWeapon = GetWorld()->SpawnActor<AWeapon>(WeaponClass);
-		if (EquippedWeapon)
-		{
-			// Attach weapon to the enemy's hand socket
-			if (GetMesh()->DoesSocketExist(FName("hand_r")))
-			{
-				EquippedWeapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, FName("hand_r"));
-				UE_LOG(LogTemp, Warning, TEXT("Enemy weapon equipped to hand_r socket"));
-			}
-			else
-			{
-				// Fallback: attach to root component
-				EquippedWeapon->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-				UE_LOG(LogTemp, Warning, TEXT("Enemy weapon equipped to root (no hand_r socket found)"));
-			}
-			
-			// Set the weapon's owner to this enemy
-			EquippedWeapon->SetOwner(this);
-			EquippedWeapon->SetInstigator(this);
-			
-			// Initially disable weapon collision
-			DisableWeaponCollision();
-			if (GEngine)
-			{
-				GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, TEXT("Enemy: Weapon collision disabled on BeginPlay"));
-			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to spawn enemy weapon"));
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Enemy WeaponClass is not set"));
-	}
+	EquipWeapon();
 
 	// TEMPORARY: Disabled for weapon collision debugging
-	// Enemy will not start patrolling during debugging
-	// MoveToTarget(PatrolTarget);
+	// Enemy will not start patrolling during debugging unless bEnableCombatAI is set
+	if (bEnableCombatAI)
+	{
+		MoveToTarget(PatrolTarget);
+	}
 }
 
 bool AEnemy::InTargetRange(AActor* Target, double Radius)
 {
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseEnemyInTargetRange);
+
     if (Target == nullptr) return false;
     // Use horizontal distance to avoid Z offsets preventing attacks
     const double DistanceToTarget = FVector::Dist2D(Target->GetActorLocation(), GetActorLocation());
@@ -213,15 +191,19 @@ bool AEnemy::InTargetRange(AActor* Target, double Radius)
 
 void AEnemy::MoveToTarget(AActor* Target)
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseEnemyMoveToTarget);
+	ECLIPSE_PERF_BUDGET(EnemyMoveToTarget, 80.0);
+	LLM_SCOPE_BYTAG(Eclipse_AI);
+
 	if (!EnemyController)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MoveToTarget: Enemy controller is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("MoveToTarget: Enemy controller is null"));
 		return;
 	}
 
 	if (!Target)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("MoveToTarget: Target is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("MoveToTarget: Target is null"));
 		return;
 	}
 
@@ -231,7 +213,7 @@ void AEnemy::MoveToTarget(AActor* Target)
 		FVector CurrentGoal = EnemyController->GetPathFollowingComponent()->GetPathDestination();
 		if (FVector::DistSquared(CurrentGoal, Target->GetActorLocation()) < 10000.f)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("MoveToTarget: Already moving to target"));
+			ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("MoveToTarget: Already moving to target"));
 			return;
 		}
 	}
@@ -265,35 +247,34 @@ void AEnemy::MoveToTarget(AActor* Target)
 	MoveRequest.SetAllowPartialPath(true);
 
 	EnemyController->MoveTo(MoveRequest);
-	UE_LOG(LogTemp, Warning, TEXT("MoveToTarget: Moving to new target"));
+	ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("MoveToTarget: Moving to new target"));
 }
 
 void AEnemy::Attack()
 {
 	if (ActionState != EActionState::EAS_Unoccupied)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Attack: Already attacking"));
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Attack: Already attacking"));
 		return;
 	}
 
 	if (!GetMesh() || !GetMesh()->GetAnimInstance())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Attack: Mesh or AnimInstance is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("Attack: Mesh or AnimInstance is null"));
 		return;
 	}
 
 	if (!AttackMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Attack: AttackMontage is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("Attack: AttackMontage is null"));
 		return;
 	}
 
 	Super::Attack();
-	ActionState = EActionState::EAS_Attacking;
+	SetActionState(EActionState::EAS_Attacking);
 
-	// Clear hit actors for new attack
-	HitActors.Empty();
-	ClearWeaponHitActors();
+	// New swing id, so earlier hits don't block this attack
+	StartNewSwing();
 
 	// Temporarily disable movement rotation to prevent conflicts during attack
 	GetCharacterMovement()->bOrientRotationToMovement = false;
@@ -307,7 +288,7 @@ void AEnemy::Attack()
 		Direction.Z = 0.f;
 		FRotator NewRotation = Direction.Rotation();
 		SetActorRotation(NewRotation);
-		UE_LOG(LogTemp, Warning, TEXT("Attack: Facing player and disabled movement rotation"));
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Attack: Facing player and disabled movement rotation"));
 	}
 
 	// Play attack montage
@@ -317,30 +298,26 @@ void AEnemy::Attack()
 void AEnemy::AttackEnd()
 {
 	Super::AttackEnd();
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 	
 	// Restore movement rotation settings
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	GetCharacterMovement()->bUseControllerDesiredRotation = false;
 	
-	// Clear the hit actors list for the next attack
-	HitActors.Empty();
-	ClearWeaponHitActors();
-	
-	UE_LOG(LogTemp, Warning, TEXT("Enemy AttackEnd: Restored movement rotation and cleared hit actors"));
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy AttackEnd: Restored movement rotation"));
 }
 
 void AEnemy::PlayAttackMontage()
 {
 	if (!GetMesh() || !GetMesh()->GetAnimInstance())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlayAttackMontage: Mesh or AnimInstance is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("PlayAttackMontage: Mesh or AnimInstance is null"));
 		return;
 	}
 
 	if (!AttackMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PlayAttackMontage: AttackMontage is null"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("PlayAttackMontage: AttackMontage is null"));
 		return;
 	}
 
@@ -353,18 +330,20 @@ void AEnemy::PlayAttackMontage()
 	}
 
 	// Set montage blend settings for smoother transitions
+	INC_DWORD_STAT(STAT_EclipseMontagePlays);
 	AnimInstance->Montage_Play(AttackMontage, 1.0f);
 	
 	// Always play the first attack when starting a new sequence
 	FName SectionName = FName("Attack1");
 	AnimInstance->Montage_JumpToSection(SectionName, AttackMontage);
+	BeginAttackTrajectory(SectionName);
 	
 	// Bind the montage end delegate
 	FOnMontageEnded EndDelegate;
 	EndDelegate.BindUObject(this, &AEnemy::OnAttackMontageEnded);
 	AnimInstance->Montage_SetEndDelegate(EndDelegate, AttackMontage);
 
-	UE_LOG(LogTemp, Warning, TEXT("PlayAttackMontage: Started attack montage"));
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("PlayAttackMontage: Started attack montage"));
 }
 
 void AEnemy::OnAttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
@@ -373,8 +352,8 @@ void AEnemy::OnAttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 
 	if (Montage == AttackMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("OnAttackMontageEnded: Attack montage ended"));
-		ActionState = EActionState::EAS_Unoccupied;
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("OnAttackMontageEnded: Attack montage ended"));
+		SetActionState(EActionState::EAS_Unoccupied);
 		
 		AttackCount = 0;
 	}
@@ -382,20 +361,42 @@ void AEnemy::OnAttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 
 AActor* AEnemy::ChoosePatrolTarget()
 {
-	TArray<AActor*> ValidTargets;
-	for (AActor* Target : PatrolTargets)
+	ECLIPSE_ALLOC_SCOPE(EnemyChoosePatrolTarget);
+
+	// Pick uniformly among the distinct targets other than the current one, without building a list
+	auto IsCandidate = [this](int32 Index)
 	{
-		if (Target != PatrolTarget)
+		AActor* Target = PatrolTargets[Index];
+		if (Target == PatrolTarget)
 		{
-			ValidTargets.AddUnique(Target);
+			return false;
 		}
+		for (int32 Earlier = 0; Earlier < Index; ++Earlier)
+		{
+			if (PatrolTargets[Earlier] == Target)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	int32 NumPatrolTargets = 0;
+	for (int32 Index = 0; Index < PatrolTargets.Num(); ++Index)
+	{
+		NumPatrolTargets += IsCandidate(Index) ? 1 : 0;
 	}
-	const int32 NumPatrolTargets = ValidTargets.Num();
+
 	if (NumPatrolTargets > 0)
 	{
-		const int32 TargetSelection = FMath::RandRange(0, NumPatrolTargets - 1);
-		return  ValidTargets[TargetSelection];
-
+		int32 TargetSelection = RandomStream.RandRange(0, NumPatrolTargets - 1);
+		for (int32 Index = 0; Index < PatrolTargets.Num(); ++Index)
+		{
+			if (IsCandidate(Index) && TargetSelection-- == 0)
+			{
+				return PatrolTargets[Index];
+			}
+		}
 	}
 	return nullptr;
 }
@@ -405,6 +406,7 @@ void AEnemy::PlayHitReactMontage(const FName& SectionName)
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (AnimInstance && HitReactMontage)
 	{
+		INC_DWORD_STAT(STAT_EclipseMontagePlays);
 		AnimInstance->Montage_Play(HitReactMontage);
 		AnimInstance->Montage_JumpToSection(SectionName, HitReactMontage);
 
@@ -413,22 +415,55 @@ void AEnemy::PlayHitReactMontage(const FName& SectionName)
 
 
 
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (!bIsDead)
+	{
+		FEclipseLiveCounters::AddLiveEnemies(-1);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEnemy::SpawnDefaultController()
+{
+	// AI controller plus its path following and blackboard components
+	LLM_SCOPE_BYTAG(Eclipse_AI);
+	Super::SpawnDefaultController();
+}
+
+void AEnemy::SetEnemyState(EEnemyState NewState)
+{
+	if (EnemyState != NewState)
+	{
+		ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::EnemyStateChange, this, nullptr, 0.f, GetActorLocation(),
+			static_cast<uint8>(EnemyState), static_cast<uint8>(NewState));
+	}
+	EnemyState = NewState;
+}
+
+void AEnemy::SetActionState(EActionState NewState)
+{
+	if (ActionState != NewState)
+	{
+		ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::ActionStateChange, this, nullptr, 0.f, GetActorLocation(),
+			static_cast<uint8>(ActionState), static_cast<uint8>(NewState));
+	}
+	ActionState = NewState;
+}
+
 void AEnemy::Die()
 {
+	if (!bIsDead)
+	{
+		FEclipseLiveCounters::AddLiveEnemies(-1);
+	}
+
 	// Set the death flag
 	bIsDead = true;
+	ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::Die, this, nullptr, 0.f, GetActorLocation());
 
-	// Clear this enemy from being targeted in the HUD
-	if (APlayerController* PlayerController = Cast<APlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0)))
-	{
-		if (AMainHUD* MainHUD = Cast<AMainHUD>(PlayerController->GetHUD()))
-		{
-			if (MainHUD->GetTargetedEnemy() == this)
-			{
-				MainHUD->ClearTargetedEnemy();
-			}
-		}
-	}
+	ClearHUDTarget();
 
 	// Stop any existing movement and AI
 	if (EnemyController)
@@ -437,14 +472,8 @@ void AEnemy::Die()
 		EnemyController->UnPossess();
 	}
 
-	// Disable weapon collision and destroy weapon
-	if (EquippedWeapon)
-	{
-		DisableWeaponCollision();
-		EquippedWeapon->Destroy();
-		EquippedWeapon = nullptr;
-		UE_LOG(LogTemp, Warning, TEXT("Enemy Die: Weapon destroyed"));
-	}
+	// Disable weapon collision and put the weapon away
+	ReleaseWeapon();
 
 	// Disable collision and movement
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -461,7 +490,7 @@ void AEnemy::Die()
 		// Stop any existing montages first
 		AnimInstance->StopAllMontages(0.0f);
 		
-		const int32 Selection = FMath::RandRange(0, 1);
+		const int32 Selection = RandomStream.RandRange(0, 1);
 		switch (Selection)
 		{
 		case 0:
@@ -477,15 +506,16 @@ void AEnemy::Die()
 		}
 
 		// Play the death animation
+		INC_DWORD_STAT(STAT_EclipseMontagePlays);
 		AnimInstance->Montage_Play(DeathMontage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 		AnimInstance->Montage_JumpToSection(SectionName, DeathMontage);
 
 		// Get the length of the current section
 		float SectionLength = DeathMontage->GetSectionLength(DeathMontage->GetSectionIndex(SectionName));
 		
-		// Set up a timer to jump to the last frame section
+		// Set up a timer to jump to the last frame section (weak so a destroyed corpse cancels it)
 		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this, AnimInstance, MontageToUse, SectionName, SectionLength]()
+		GetWorld()->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateWeakLambda(this, [this, AnimInstance, MontageToUse, SectionName, SectionLength]()
 		{
 			if (AnimInstance && DeathMontage)
 			{
@@ -497,11 +527,192 @@ void AEnemy::Die()
 				// Disable animation updates to freeze the pose
 				GetMesh()->bPauseAnims = true;
 			}
-		}, SectionLength, false); // Wait for the full animation to play
+		}), SectionLength, false); // Wait for the full animation to play
 	}
 	
 }
 
+void AEnemy::ClearHUDTarget()
+{
+	// Clear this enemy from being targeted in the HUD
+	if (APlayerController* PlayerController = Cast<APlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0)))
+	{
+		if (AMainHUD* MainHUD = Cast<AMainHUD>(PlayerController->GetHUD()))
+		{
+			if (MainHUD->GetTargetedEnemy() == this)
+			{
+				MainHUD->ClearTargetedEnemy();
+			}
+		}
+	}
+}
+
+void AEnemy::OnAcquiredFromPool()
+{
+	LLM_SCOPE_BYTAG(Eclipse_Enemies);
+
+	ResetCombatState();
+	if (bDisableAllCollision && GetMesh())
+	{
+		GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	bIsDead = false;
+	DeathPose = EDeathPose::EDP_Alive;
+	SetEnemyState(EEnemyState::EES_Patrolling);
+	SetActionState(EActionState::EAS_Unoccupied);
+	AttackCount = 0;
+
+	// Die turns the capsule off and stops movement
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	// The controller unpossessed on death is reused
+	if (!GetController() && AutoPossessAI != EAutoPossessAI::Disabled)
+	{
+		if (EnemyController && !EnemyController->GetPawn())
+		{
+			EnemyController->Possess(this);
+		}
+		else
+		{
+			SpawnDefaultController();
+		}
+	}
+
+	FEclipseLiveCounters::AddLiveEnemies(1);
+	StartEnemy();
+}
+
+void AEnemy::OnReleasedToPool()
+{
+	// Patrol wait and the death pose freeze
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	if (!bIsDead)
+	{
+		FEclipseLiveCounters::AddLiveEnemies(-1);
+		bIsDead = true;
+		ClearHUDTarget();
+	}
+
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		EnemyController = AIController;
+		AIController->StopMovement();
+		AIController->UnPossess();
+	}
+
+	ReleaseWeapon();
+}
+
+void AEnemy::EquipWeapon()
+{
+	if (EquippedWeapon || (WeaponComponent && WeaponComponent->IsEquipped()))
+	{
+		return;
+	}
+
+	// Weapon component when the character uses one, otherwise take a weapon actor from the pool and equip it
+	if (WeaponClass && UsesWeaponComponent())
+	{
+		if (WeaponComponent->Equip(WeaponClass))
+		{
+			DisableWeaponCollision();
+			ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy weapon equipped as a component"));
+		}
+		else
+		{
+			UE_LOG(LogEclipseCombat, Error, TEXT("Enemy WeaponClass %s has no sword mesh to equip"), *GetNameSafe(WeaponClass));
+		}
+	}
+	else if (WeaponClass)
+	{
+		LLM_SCOPE_BYTAG(Eclipse_Weapons);
+		EquippedWeapon = UCombatActorPoolSubsystem::Acquire<AWeapon>(this, WeaponClass, GetActorTransform(), this, this);
+		if (EquippedWeapon)
+		{
+			// Attach weapon to the enemy's hand socket
+			if (GetMesh()->DoesSocketExist(FName("hand_r")))
+			{
+				EquippedWeapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, FName("hand_r"));
+				ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy weapon equipped to hand_r socket"));
+			}
+			else
+			{
+				// Fallback: attach to root component
+				EquippedWeapon->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+				ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy weapon equipped to root (no hand_r socket found)"));
+			}
+			
+			// Set the weapon's owner to this enemy
+			EquippedWeapon->SetOwner(this);
+			EquippedWeapon->SetInstigator(this);
+			AWeapon::NotifyAttachmentsChanged(this);
+			
+			// Initially disable weapon collision
+			DisableWeaponCollision();
+			ECLIPSE_SCREEN_MESSAGE(3.0f, FColor::Yellow, TEXT("Enemy: Weapon collision disabled on BeginPlay"));
+		}
+		else
+		{
+			UE_LOG(LogEclipseCombat, Error, TEXT("Failed to spawn enemy weapon"));
+		}
+	}
+	else if (CombatAssets && !CombatAssets->IsLoaded())
+	{
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy weapon waits for its combat assets"));
+	}
+	else
+	{
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("Enemy WeaponClass is not set"));
+	}
+}
+
+void AEnemy::ApplyCombatAssets()
+{
+	Super::ApplyCombatAssets();
+
+	if (UAnimMontage* Montage = CombatAssets ? CombatAssets->DeathMontage.Get() : nullptr)
+	{
+		DeathMontage = Montage;
+	}
+
+	// Streamed in after StartEnemy looked for the weapon class
+	if (HasActorBegunPlay() && !bIsDead && EnemyController)
+	{
+		EquipWeapon();
+	}
+}
+
+#if WITH_EDITOR
+EDataValidationResult AEnemy::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+	if (!ValidateReplacedByCombatAssets(Context, DeathMontage, TEXT("DeathMontage")))
+	{
+		Result = EDataValidationResult::Invalid;
+	}
+	return Result;
+}
+#endif
+
+void AEnemy::ReleaseWeapon()
+{
+	if (WeaponComponent && WeaponComponent->IsEquipped())
+	{
+		WeaponComponent->Unequip();
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy: Weapon component unequipped"));
+	}
+
+	if (EquippedWeapon)
+	{
+		DisableWeaponCollision();
+		UCombatActorPoolSubsystem::Release(EquippedWeapon);
+		EquippedWeapon = nullptr;
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy: Weapon released"));
+	}
+}
+
 void AEnemy::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -510,7 +721,8 @@ void AEnemy::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 
 void AEnemy::GetHit(const FVector& ImpactPoint)
 {
-	
+	ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::GetHit, nullptr, this, Attributes ? Attributes->GetHealthPercent() : 0.f, ImpactPoint);
+
 	if (Attributes && Attributes->IsAlive()) 
 	{
 		DirectionalHitReact(ImpactPoint);
@@ -522,18 +734,7 @@ void AEnemy::GetHit(const FVector& ImpactPoint)
 	}
 	
 
-	if (HitSound)
-	{
-		UGameplayStatics::PlaySoundAtLocation(this, HitSound, ImpactPoint);
-	}
-	if (HitParticles && GetWorld())
-	{
-		UGameplayStatics::SpawnEmitterAtLocation(
-			GetWorld(),
-			HitParticles,
-			ImpactPoint
-		);
-	}
+	UCombatEffectsSubsystem::PlayHitEffects(this, HitParticles, HitSound, ImpactPoint);
 
 }
 
@@ -542,6 +743,7 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 	if (Attributes && HealthBarWidget1)
 	{
 		Attributes->ReceiveDamage(DamageAmount);
+		UCombatReplaySubsystem::NotifyDamageTaken(this, DamageAmount);
 		HealthBarWidget1->SetHealthPercent(Attributes->GetHealthPercent());
 		
 		// Update the HUD enemy health bar if this enemy is currently targeted
@@ -555,11 +757,12 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 				}
 			}
 		}
+		ECLIPSE_LATENCY_MARK(EventInstigator ? EventInstigator->GetPawn() : DamageCauser, HealthBar);
 		
 		// Only update state and movement if we're not currently attacking
 		if (ActionState != EActionState::EAS_Attacking)
 		{
-			EnemyState = EEnemyState::EES_Chasing;
+			SetEnemyState(EEnemyState::EES_Chasing);
 			GetCharacterMovement()->MaxWalkSpeed = 300.f;
 			
 			// Only update target if we're not already moving to it
@@ -576,17 +779,17 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 
 void AEnemy::PatrolTimerFinished()
 {
-	UE_LOG(LogTemp, Warning, TEXT("Patrol timer finished"));
+	ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("Patrol timer finished"));
 	
 	if (!EnemyController)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PatrolTimerFinished: Enemy controller is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("PatrolTimerFinished: Enemy controller is null"));
 		return;
 	}
 
 	if (!PatrolTarget)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PatrolTimerFinished: Patrol target is null"));
+		ECLIPSE_LOG(LogEclipseAI, Warning, TEXT("PatrolTimerFinished: Patrol target is null"));
 		return;
 	}
 
@@ -607,6 +810,8 @@ void AEnemy::CheckPatroTarget()
 
 void AEnemy::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
 {
+	LLM_SCOPE_BYTAG(Eclipse_AI);
+
 	// TEMPORARY: Disabled for weapon collision debugging
 	// Enemy will not react to player detection during debugging
 	return;
@@ -622,17 +827,17 @@ void AEnemy::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
 			// Only change state if not already chasing to prevent rapid transitions
 			if (EnemyState != EEnemyState::EES_Chasing)
 			{
-				EnemyState = EEnemyState::EES_Chasing;
-				UE_LOG(LogTemp, Warning, TEXT("OnPerceptionUpdated: State changed to Chasing"));
+				SetEnemyState(EEnemyState::EES_Chasing);
+				ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("OnPerceptionUpdated: State changed to Chasing"));
 				if (GEngine)
 				{
-					GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Perception: Chasing player"));
+					ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Orange, TEXT("Perception: Chasing player"));
 				}
 			}
 			MoveToTarget(PlayerPawn);
 			if (GEngine)
 			{
-				GEngine->AddOnScreenDebugMessage(-1, 1.5f, FColor::Silver, TEXT("Perception: MoveTo Target (player)"));
+				ECLIPSE_SCREEN_MESSAGE(1.5f, FColor::Silver, TEXT("Perception: MoveTo Target (player)"));
 			}
 		}
 	}
@@ -640,11 +845,11 @@ void AEnemy::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
 	// If no player is seen, go back to patrolling
 	if (!bPlayerSeen && EnemyState != EEnemyState::EES_Patrolling)
 	{
-		EnemyState = EEnemyState::EES_Patrolling;
-		UE_LOG(LogTemp, Warning, TEXT("OnPerceptionUpdated: State changed to Patrolling"));
+		SetEnemyState(EEnemyState::EES_Patrolling);
+		ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("OnPerceptionUpdated: State changed to Patrolling"));
 		if (GEngine)
 		{
-			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Cyan, TEXT("Perception: Patrolling"));
+			ECLIPSE_SCREEN_MESSAGE(2.0f, FColor::Cyan, TEXT("Perception: Patrolling"));
 		}
 		CheckPatroTarget();
 	}
@@ -653,32 +858,33 @@ void AEnemy::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
 
 void AEnemy::Tick(float DeltaTime)
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseEnemyTick);
+
 	Super::Tick(DeltaTime);
 
 	// TEMPORARY: Disabled for weapon collision debugging
-	// Enemy will not move or attack during debugging
-	return;
+	// Enemy will not move or attack during debugging unless bEnableCombatAI is set
+	if (!bEnableCombatAI) return;
 
-	/*
-	if (EnemyState == EEnemyState::EES_Dead) return;
+	if (bIsDead || EnemyState == EEnemyState::EES_Dead) return;
 
 	if (EnemyState == EEnemyState::EES_Patrolling)
 	{
-		if (PatrolTarget && InTargetRange(PatrolTarget, PatrolRadius))
+		if (PatrolTarget && InTargetRange(PatrolTarget, PatrolRadius) && !GetWorldTimerManager().IsTimerActive(PatrolTimer))
 		{
-			// Start timer to move to next patrol point
+			// Pick the next patrol point and wait before moving to it
+			PatrolTarget = ChoosePatrolTarget();
 			GetWorldTimerManager().SetTimer(
 				PatrolTimer,
 				this,
 				&AEnemy::PatrolTimerFinished,
-				FMath::RandRange(WaitMin, WaitMax)
+				RandomStream.FRandRange(WaitMin, WaitMax)
 			);
-			UE_LOG(LogTemp, Warning, TEXT("Tick: Started patrol timer"));
+			ECLIPSE_LOG(LogEclipseAI, Verbose, TEXT("Tick: Started patrol timer"));
 		}
+		return;
 	}
 
-	if (bIsDead) return;
-
 	// Get the player pawn
 	APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
 	if (!PlayerPawn) return;
@@ -693,57 +899,60 @@ void AEnemy::Tick(float DeltaTime)
 
 		if (ActionState == EActionState::EAS_Unoccupied)
 		{
+			SetEnemyState(EEnemyState::EES_Attacking);
 			Attack();
 		}
 	}
 	else
 	{
+		SetEnemyState(EEnemyState::EES_Chasing);
+
 		// Only move to target if we're not already moving to it to prevent excessive calls
 		if (EnemyController && EnemyController->GetMoveStatus() != EPathFollowingStatus::Moving)
 		{
 			MoveToTarget(PlayerPawn);
 		}
 	}
-	*/
+}
+
+void AEnemy::SetPatrolTargets(const TArray<AActor*>& InPatrolTargets, AActor* InPatrolTarget)
+{
+	PatrolTargets = InPatrolTargets;
+	PatrolTarget = InPatrolTarget;
 }
 
 // Weapon collision system implementation
 void AEnemy::SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled)
 {
-	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	if (WeaponComponent && WeaponComponent->IsEquipped())
 	{
-		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(CollisionEnabled);
-		UE_LOG(LogTemp, Warning, TEXT("Enemy SetWeaponCollisionEnabled: %s"), 
+		WeaponComponent->SetCollisionWindowEnabled(CollisionEnabled != ECollisionEnabled::NoCollision);
+	}
+	else if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
+	{
+		EquippedWeapon->SetCollisionWindowEnabled(CollisionEnabled);
+		ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy SetWeaponCollisionEnabled: %s"), 
 			CollisionEnabled == ECollisionEnabled::QueryOnly ? TEXT("Enabled") : TEXT("Disabled"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Enemy SetWeaponCollisionEnabled: No equipped weapon or weapon box"));
+		ECLIPSE_LOG(LogEclipseCombat, Warning, TEXT("Enemy SetWeaponCollisionEnabled: No equipped weapon or weapon box"));
 	}
 }
 
 void AEnemy::EnableWeaponCollision()
 {
 	SetWeaponCollisionEnabled(ECollisionEnabled::QueryOnly);
-	ClearWeaponHitActors();
-	UE_LOG(LogTemp, Warning, TEXT("Enemy EnableWeaponCollision: Weapon collision enabled"));
+	StartNewSwing();
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy EnableWeaponCollision: Weapon collision enabled"));
 }
 
 void AEnemy::DisableWeaponCollision()
 {
 	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
-	UE_LOG(LogTemp, Warning, TEXT("Enemy DisableWeaponCollision: Weapon collision disabled"));
+	ECLIPSE_LOG(LogEclipseCombat, Verbose, TEXT("Enemy DisableWeaponCollision: Weapon collision disabled"));
 }
 
-void AEnemy::ClearWeaponHitActors()
-{
-	if (EquippedWeapon)
-	{
-		EquippedWeapon->ClearHitActors();
-	}
-	HitActors.Empty();
-	UE_LOG(LogTemp, Warning, TEXT("Enemy ClearWeaponHitActors: Cleared weapon hit actors"));
-}
 
 
 
@@ -2,6 +2,7 @@
 #include "Enemy/Enemy.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Diagnostics/EclipseStats.h"
 
 UEnemyAnimInstance::UEnemyAnimInstance()
 {
@@ -20,6 +21,8 @@ void UEnemyAnimInstance::NativeInitializeAnimation()
 
 void UEnemyAnimInstance::NativeUpdateAnimation(float DeltaTime)
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseEnemyAnimUpdate);
+
 	Super::NativeUpdateAnimation(DeltaTime);
 
 	if (Enemy == nullptr)
@@ -3,17 +3,21 @@
 
 #include "HUD/Character_Overlay.h"
 #include "Components/ProgressBar.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipsePerfBudget.h"
 
 
 void UCharacter_Overlay::SetHealthBarPercent(float Percent)
 {
+	ECLIPSE_PERF_BUDGET(HUDOverlayHealthBar, 15.0);
+
 	if (HealthProgressBar)
 	{
 		HealthProgressBar->SetPercent(Percent);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetHealthBarPercent: HealthProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'HealthProgressBar'"));
+		UE_LOG(LogEclipseHUD, Error, TEXT("SetHealthBarPercent: HealthProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'HealthProgressBar'"));
 	}
 }
 
@@ -25,19 +29,21 @@ void UCharacter_Overlay::SetStaminaBarPercent(float Percent)
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetStaminaBarPercent: StaminaProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'StaminaProgressBar'"));
+		UE_LOG(LogEclipseHUD, Error, TEXT("SetStaminaBarPercent: StaminaProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'StaminaProgressBar'"));
 	}
 }
 
 void UCharacter_Overlay::SetEnemyHealthBarPercent(float Percent)
 {
+	ECLIPSE_PERF_BUDGET(HUDOverlayEnemyHealthBar, 15.0);
+
 	if (EnemyHealthProgressBar)
 	{
 		EnemyHealthProgressBar->SetPercent(Percent);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetEnemyHealthBarPercent: EnemyHealthProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'EnemyHealthProgressBar'"));
+		UE_LOG(LogEclipseHUD, Error, TEXT("SetEnemyHealthBarPercent: EnemyHealthProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'EnemyHealthProgressBar'"));
 	}
 }
 
@@ -49,7 +55,7 @@ void UCharacter_Overlay::SetEnemyStaminaBarPercent(float Percent)
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetEnemyStaminaBarPercent: EnemyStaminaProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'EnemyStaminaProgressBar'"));
+		UE_LOG(LogEclipseHUD, Error, TEXT("SetEnemyStaminaBarPercent: EnemyStaminaProgressBar is null! Make sure your Blueprint widget has a ProgressBar with variable name 'EnemyStaminaProgressBar'"));
 	}
 }
 
@@ -4,9 +4,20 @@
 #include "HUD/HealthBarComponent.h"
 #include "HUD/HealthBar1.h"
 #include "Components/ProgressBar.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+
+void UHealthBarComponent::InitWidget()
+{
+	// The widget itself is created here, not when the component is constructed
+	LLM_SCOPE_BYTAG(Eclipse_HUD);
+	Super::InitWidget();
+}
 
 void UHealthBarComponent::SetHealthPercent(float Percent)
 {
+	ECLIPSE_PERF_BUDGET(HUDEnemyHealthBar, 15.0);
+
 	if (HealthBarWidget1 == nullptr)
 	{
 		HealthBarWidget1 = Cast<UHealthBar1>(GetUserWidgetObject());
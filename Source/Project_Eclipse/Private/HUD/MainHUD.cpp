@@ -5,10 +5,16 @@
 #include "HUD/Character_Overlay.h"
 #include "Enemy/Enemy.h"
 #include "Components/AttributeComponent.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
 
 
 void AMainHUD::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Eclipse_HUD);
+
 	Super::BeginPlay();
 	UWorld* World = GetWorld();
 	if (World)
@@ -27,6 +33,9 @@ void AMainHUD::BeginPlay()
 
 void AMainHUD::SetTargetedEnemy(AEnemy* Enemy)
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseHUDSetTargetedEnemy);
+	ECLIPSE_PERF_BUDGET(HUDSetTargetedEnemy, 20.0);
+
 	TargetedEnemy = Enemy;
 	
 	// Update the enemy health bar if we have a character overlay
@@ -40,17 +49,20 @@ void AMainHUD::SetTargetedEnemy(AEnemy* Enemy)
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("SetTargetedEnemy: Enemy has no Attributes component!"));
+			ECLIPSE_LOG(LogEclipseHUD, Warning, TEXT("SetTargetedEnemy: Enemy has no Attributes component!"));
 		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("SetTargetedEnemy: Character_Overlay is null or Enemy is null!"));
+		ECLIPSE_LOG(LogEclipseHUD, Warning, TEXT("SetTargetedEnemy: Character_Overlay is null or Enemy is null!"));
 	}
 }
 
 void AMainHUD::ClearTargetedEnemy()
 {
+	ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseHUDClearTargetedEnemy);
+	ECLIPSE_PERF_BUDGET(HUDClearTargetedEnemy, 20.0);
+
 	TargetedEnemy = nullptr;
 	
 	// Hide the enemy health bar by setting it to 0
@@ -60,6 +72,6 @@ void AMainHUD::ClearTargetedEnemy()
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("ClearTargetedEnemy: Character_Overlay is null!"));
+		ECLIPSE_LOG(LogEclipseHUD, Warning, TEXT("ClearTargetedEnemy: Character_Overlay is null!"));
 	}
 }
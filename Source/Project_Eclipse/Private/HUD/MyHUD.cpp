@@ -1,35 +1,39 @@
 #include "HUD/MyHUD.h"
 #include "HUD/PlayerHealthBar.h"
 #include "Blueprint/UserWidget.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseMemory.h"
 
 AMyHUD::AMyHUD()
 {
-    UE_LOG(LogTemp, Warning, TEXT("MyHUD Constructor Called"));
+    ECLIPSE_LOG(LogEclipseHUD, Verbose, TEXT("MyHUD Constructor Called"));
 }
 
 void AMyHUD::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(Eclipse_HUD);
+
     Super::BeginPlay();
-    UE_LOG(LogTemp, Warning, TEXT("MyHUD BeginPlay Called"));
+    ECLIPSE_LOG(LogEclipseHUD, Verbose, TEXT("MyHUD BeginPlay Called"));
 
     if (PlayerHealthBarClass)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PlayerHealthBarClass is valid"));
+        ECLIPSE_LOG(LogEclipseHUD, Verbose, TEXT("PlayerHealthBarClass is valid"));
         PlayerHealthBarWidget = CreateWidget<UPlayerHealthBar>(GetWorld(), PlayerHealthBarClass);
         if (PlayerHealthBarWidget)
         {
-            UE_LOG(LogTemp, Warning, TEXT("PlayerHealthBarWidget created successfully"));
+            ECLIPSE_LOG(LogEclipseHUD, Verbose, TEXT("PlayerHealthBarWidget created successfully"));
             PlayerHealthBarWidget->AddToViewport();
             PlayerHealthBarWidget->SetHealthPercent(1.f);
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to create PlayerHealthBarWidget"));
+            UE_LOG(LogEclipseHUD, Error, TEXT("Failed to create PlayerHealthBarWidget"));
         }
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("PlayerHealthBarClass is null"));
+        UE_LOG(LogEclipseHUD, Error, TEXT("PlayerHealthBarClass is null"));
     }
 }
 
@@ -0,0 +1,8 @@
+#include "Interfaces/Combatant.h"
+#include "Interfaces/HitInterface.h"
+
+ICombatant* ICombatant::Resolve(AActor* Actor)
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(Actor);
+	return HitInterface ? HitInterface->AsCombatant() : nullptr;
+}
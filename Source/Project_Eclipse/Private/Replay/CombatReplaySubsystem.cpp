@@ -0,0 +1,278 @@
+#include "Replay/CombatReplaySubsystem.h"
+#include "Characters/MyCharacter.h"
+#include "Diagnostics/EclipseLog.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 ReplayFileMagic = 0x50524345; // 'ECRP'
+	constexpr uint32 ReplayFileVersion = 1;
+
+	FString ReplayDirectory()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Replays");
+	}
+}
+
+int32 UCombatReplaySubsystem::MakeActorSeed(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UCombatReplaySubsystem* Replay = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr;
+	if (!Replay || Replay->Mode == EMode::None)
+	{
+		return FMath::Rand();
+	}
+
+	// Actors begin play in the same order on every run of the same session, so the n-th seed matches
+	return static_cast<int32>(HashCombine(GetTypeHash(Replay->SessionSeed), GetTypeHash(Replay->NextActorSeed++)));
+}
+
+void UCombatReplaySubsystem::NotifyDamageTaken(const AActor* DamagedActor, float Damage)
+{
+	const UWorld* World = DamagedActor ? DamagedActor->GetWorld() : nullptr;
+	UCombatReplaySubsystem* Replay = World ? World->GetSubsystem<UCombatReplaySubsystem>() : nullptr;
+	if (Replay && Replay->Mode != EMode::None)
+	{
+		Replay->DamageTotal += Damage;
+		++Replay->DamageEvents;
+	}
+}
+
+void UCombatReplaySubsystem::RecordInput(ECombatInputAction Action, const FVector2D& Value)
+{
+	if (Mode != EMode::Recording)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Eclipse_Combat);
+	FRecordedInput& Input = Inputs.AddDefaulted_GetRef();
+	Input.Frame = FrameIndex;
+	Input.Action = Action;
+	Input.Value = FVector2f(Value);
+}
+
+bool UCombatReplaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	if (!World || !World->IsGameWorld())
+	{
+		return false;
+	}
+
+	FString Unused;
+	const TCHAR* CommandLine = FCommandLine::Get();
+	return FParse::Value(CommandLine, TEXT("EclipseRecord="), Unused) || FParse::Value(CommandLine, TEXT("EclipseReplay="), Unused);
+}
+
+void UCombatReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	if (FParse::Value(CommandLine, TEXT("EclipseReplay="), SessionName))
+	{
+		FilePath = ReplayDirectory() / SessionName + TEXT(".ecrp");
+		if (!LoadRecording())
+		{
+			UE_LOG(LogEclipse, Error, TEXT("CombatReplay: Could not load %s"), *FilePath);
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+			return;
+		}
+		Mode = EMode::Replaying;
+	}
+	else if (FParse::Value(CommandLine, TEXT("EclipseRecord="), SessionName))
+	{
+		FilePath = ReplayDirectory() / SessionName + TEXT(".ecrp");
+		float FixedFPS = 30.f;
+		FParse::Value(CommandLine, TEXT("EclipseReplayFPS="), FixedFPS);
+		FixedDeltaTime = 1.f / FMath::Max(FixedFPS, 1.f);
+		SessionSeed = FMath::Rand();
+		Mode = EMode::Recording;
+	}
+
+	// Fixed timestep and seeded global RNG so frame N simulates the same thing on every run
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedDeltaTime);
+	FMath::RandInit(SessionSeed);
+	FMath::SRandInit(SessionSeed);
+
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UCombatReplaySubsystem::OnWorldTickStart);
+
+	UE_LOG(LogEclipse, Display, TEXT("CombatReplay: %s '%s' (seed %d, %.1f fps fixed)"),
+		Mode == EMode::Recording ? TEXT("Recording") : TEXT("Replaying"), *SessionName, SessionSeed, 1.f / FixedDeltaTime);
+}
+
+void UCombatReplaySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+
+	if (Mode == EMode::Recording)
+	{
+		SaveRecording();
+	}
+	else if (Mode == EMode::Replaying && !bFinished)
+	{
+		UE_LOG(LogEclipse, Warning, TEXT("CombatReplay: World torn down after %u of %u frames"), FrameIndex, RecordedFrames);
+	}
+
+	Mode = EMode::None;
+	Super::Deinitialize();
+}
+
+void UCombatReplaySubsystem::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || !InWorld->HasBegunPlay() || bFinished)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (LastTickStartSeconds > 0.0)
+	{
+		FrameTimesMs.Add(static_cast<float>((Now - LastTickStartSeconds) * 1000.0));
+	}
+	LastTickStartSeconds = Now;
+
+	// Inputs recorded while actors tick frame N are tagged N, so advance before anything ticks
+	++FrameIndex;
+
+	if (Mode == EMode::Replaying)
+	{
+		ApplyReplayedInputs();
+
+		if (FrameIndex >= RecordedFrames)
+		{
+			FinishReplay();
+		}
+	}
+}
+
+void UCombatReplaySubsystem::ApplyReplayedInputs()
+{
+	AMyCharacter* Player = Cast<AMyCharacter>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+
+	while (Inputs.IsValidIndex(NextInputIndex) && Inputs[NextInputIndex].Frame <= FrameIndex)
+	{
+		const FRecordedInput& Input = Inputs[NextInputIndex++];
+		if (Player)
+		{
+			Player->ApplyInput(Input.Action, FVector2D(Input.Value));
+		}
+	}
+}
+
+void UCombatReplaySubsystem::FinishReplay()
+{
+	bFinished = true;
+
+	const bool bDamageMatches = DamageEvents == RecordedDamageEvents
+		&& FMath::IsNearlyEqual(DamageTotal, RecordedDamageTotal, 0.01);
+
+	TArray<float> Sorted = FrameTimesMs;
+	Sorted.Sort();
+	double SumMs = 0.0;
+	for (const float Ms : Sorted)
+	{
+		SumMs += Ms;
+	}
+	const float MeanMs = Sorted.Num() > 0 ? static_cast<float>(SumMs / Sorted.Num()) : 0.f;
+	const float P50Ms = Sorted.Num() > 0 ? Sorted[(Sorted.Num() - 1) / 2] : 0.f;
+	const float P95Ms = Sorted.Num() > 0 ? Sorted[FMath::Clamp(FMath::CeilToInt(0.95f * Sorted.Num()) - 1, 0, Sorted.Num() - 1)] : 0.f;
+
+	if (bDamageMatches)
+	{
+		UE_LOG(LogEclipse, Display, TEXT("CombatReplay: '%s' matched (%d hits, %.1f damage). Frame mean %.2f ms, p50 %.2f ms, p95 %.2f ms"),
+			*SessionName, DamageEvents, DamageTotal, MeanMs, P50Ms, P95Ms);
+	}
+	else
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatReplay: '%s' diverged: %d hits / %.1f damage, recording had %d hits / %.1f damage"),
+			*SessionName, DamageEvents, DamageTotal, RecordedDamageEvents, RecordedDamageTotal);
+	}
+
+	const FString ResultsPath = ReplayDirectory() / SessionName + TEXT(".results.csv");
+	FString Csv;
+	if (!IFileManager::Get().FileExists(*ResultsPath))
+	{
+		Csv = TEXT("Timestamp,Build,Frames,FrameMeanMs,FrameP50Ms,FrameP95Ms,Hits,Damage,Matches\n");
+	}
+	Csv += FString::Printf(TEXT("%s,%s,%u,%.3f,%.3f,%.3f,%d,%.1f,%d\n"),
+		*FDateTime::Now().ToString(), FApp::GetBuildVersion(), FrameIndex, MeanMs, P50Ms, P95Ms,
+		DamageEvents, DamageTotal, bDamageMatches ? 1 : 0);
+	FFileHelper::SaveStringToFile(Csv, *ResultsPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+	FPlatformMisc::RequestExitWithStatus(false, bDamageMatches ? 0 : 1);
+}
+
+bool UCombatReplaySubsystem::SerializeSession(FArchive& Ar)
+{
+	uint32 Magic = ReplayFileMagic;
+	uint32 Version = ReplayFileVersion;
+	Ar << Magic << Version;
+	if (Magic != ReplayFileMagic || Version != ReplayFileVersion)
+	{
+		return false;
+	}
+
+	FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	Ar << MapName;
+	if (Ar.IsLoading() && MapName != UWorld::RemovePIEPrefix(GetWorld()->GetMapName()))
+	{
+		UE_LOG(LogEclipse, Warning, TEXT("CombatReplay: Recording was made on %s, replaying on %s"), *MapName, *GetWorld()->GetMapName());
+	}
+
+	Ar << SessionSeed << FixedDeltaTime << RecordedFrames << RecordedDamageTotal << RecordedDamageEvents << Inputs;
+	return !Ar.IsError();
+}
+
+bool UCombatReplaySubsystem::SaveRecording()
+{
+	RecordedFrames = FrameIndex;
+	RecordedDamageTotal = DamageTotal;
+	RecordedDamageEvents = DamageEvents;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	SerializeSession(Writer);
+
+	IFileManager::Get().MakeDirectory(*ReplayDirectory(), true);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogEclipse, Error, TEXT("CombatReplay: Could not write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogEclipse, Display, TEXT("CombatReplay: Recorded %u frames, %d inputs, %d hits (%.1f damage) to %s"),
+		RecordedFrames, Inputs.Num(), DamageEvents, DamageTotal, *FilePath);
+	return true;
+}
+
+bool UCombatReplaySubsystem::LoadRecording()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	return SerializeSession(Reader);
+}
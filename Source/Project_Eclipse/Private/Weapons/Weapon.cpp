@@ -2,32 +2,56 @@
 
 
 #include "Weapons/Weapon.h"
-#include "Characters/MyCharacter.h"
-#include "Enemy/Enemy.h"
-#include "HUD/MainHUD.h"
-#include "Components/BoxComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet/GameplayStatics.h"
+#include "Combat/CombatResolutionSubsystem.h"
+#include "Combat/CombatHitLedger.h"
+#include "Combat/EclipseCollision.h"
+#include "Animation/AttackTrajectoryAsset.h"
 #include "Interfaces/HitInterface.h"
+#include "Interfaces/Combatant.h"
+#include "Components/BoxComponent.h"
+#include "Components/HitboxComponent.h"
+#include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "Characters/CharacterTypes.h"
+#include "Diagnostics/EclipseStats.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseMemory.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/CombatLatencyTracker.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GEclipseWeaponHitModeOverride = -1;
+static FAutoConsoleVariableRef CVarEclipseWeaponHitMode(
+    TEXT("Eclipse.Weapon.HitMode"),
+    GEclipseWeaponHitModeOverride,
+    TEXT("Overrides AWeapon::HitMode for windows opened from now on.\n")
+    TEXT("-1: use the weapon's setting (default), 0: overlap then trace, 1: continuous blade sweeps, 2: owner's hitbox component"));
+
+static int32 GEclipseWeaponTraceModeOverride = -1;
+static FAutoConsoleVariableRef CVarEclipseWeaponTraceMode(
+    TEXT("Eclipse.Weapon.TraceMode"),
+    GEclipseWeaponTraceModeOverride,
+    TEXT("Overrides AWeapon::TraceMode for windows opened from now on.\n")
+    TEXT("-1: use the weapon's setting (default), 0: blocking traces, 1: async traces resolved next frame"));
 
 // Sets default values
 AWeapon::AWeapon()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	LLM_SCOPE_BYTAG(Eclipse_Weapons);
+
+ 	// Only ticks while a continuous hit window is open, after animation has moved the blade
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
 
 	SwordMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("SwordMesh"));
 	RootComponent = SwordMesh;
 
 	WeaponBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Weapon Box"));
 	WeaponBox->SetupAttachment(GetRootComponent());
-	WeaponBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	WeaponBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	WeaponBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
-	WeaponBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Ignore);
-	WeaponBox->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
+	FEclipseCollision::InitWeaponHitbox(WeaponBox);
 	
 	BoxTraceStart = CreateDefaultSubobject<USceneComponent>(TEXT("Box Trace Start"));
 	BoxTraceStart->SetupAttachment(GetRootComponent());
@@ -38,63 +62,189 @@ AWeapon::AWeapon()
 
 void AWeapon::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(Eclipse_Weapons);
+
 	Super::BeginPlay();
+    FEclipseCollision::ApplyLegacyHitbox(WeaponBox);
     WeaponBox->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::OnBoxOverlap);
+
+    // Room for the usual owner hierarchy and sweep hits so the first overlap or sweep does not allocate
+    OwnerIgnoreActors.Reserve(8);
+    SweepStepHits.Reserve(8);
+    SweepCandidates.Reserve(8);
+    AsyncTraceDelegate.BindUObject(this, &AWeapon::OnAsyncTraceDone);
     
     // Auto-set owner if not set
     if (!GetOwner() && GetInstigator())
     {
         SetOwner(GetInstigator());
     }
+    ResolveOwnerCombatant();
 }
 
-bool AWeapon::BoxTrace(FHitResult& OutHit)
+void AWeapon::SetOwner(AActor* NewOwner)
 {
-    if (!BoxTraceStart || !BoxTraceEnd)
+    Super::SetOwner(NewOwner);
+    ResolveOwnerCombatant();
+}
+
+void AWeapon::OnRep_Owner()
+{
+    Super::OnRep_Owner();
+    ResolveOwnerCombatant();
+}
+
+void AWeapon::ResolveOwnerCombatant()
+{
+    CombatantOwner = GetOwner();
+    OwnerCombatant = ICombatant::Resolve(GetOwner());
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    SetCollisionWindowEnabled(ECollisionEnabled::NoCollision);
+    NotifyAttachmentsChanged(GetOwner());
+    Super::EndPlay(EndPlayReason);
+}
+
+void AWeapon::OnAcquiredFromPool()
+{
+    // New owner and attachments, and nothing from the last owner's swings carries over
+    bIgnoreActorsDirty = true;
+    UntrackedHits.Reset();
+    UntrackedHitsSwingId = 0;
+}
+
+void AWeapon::OnReleasedToPool()
+{
+    SetCollisionWindowEnabled(ECollisionEnabled::NoCollision);
+    NotifyAttachmentsChanged(GetOwner());
+
+    // Async results still in flight belong to the old owner
+    ++WindowSerial;
+}
+
+void AWeapon::SetCollisionWindowEnabled(ECollisionEnabled::Type CollisionEnabled)
+{
+    if (!WeaponBox)
+    {
+        return;
+    }
+
+    const bool bOpen = CollisionEnabled != ECollisionEnabled::NoCollision;
+    if (bOpen && !bCollisionWindowOpen)
+    {
+        const EWeaponHitMode WindowHitMode = GetEffectiveHitMode();
+        bHitboxWindow = WindowHitMode == EWeaponHitMode::Hitbox && SetHitboxBladeActive(true);
+
+        // Owners without a hitbox component fall back to the weapon box overlap
+        bContinuousWindow = WindowHitMode == EWeaponHitMode::Continuous;
+        bAsyncWindow = GetEffectiveTraceMode() == EWeaponTraceMode::Async;
+        ++WindowSerial;
+        WindowSwingId = FCombatHitLedger::NewSwingId();
+
+        // Enabling the box runs an overlap query, so the owner's hierarchy must already be on its ignore list
+        GetOwnerIgnoreActors();
+    }
+    else if (!bOpen && bHitboxWindow)
+    {
+        SetHitboxBladeActive(false);
+        bHitboxWindow = false;
+    }
+
+    // Continuous windows sweep the blade from Tick instead of waiting for box overlaps; hitbox windows leave it to the owner
+    const bool bSweep = bOpen && bContinuousWindow;
+    WeaponBox->SetCollisionEnabled(bSweep || (bOpen && bHitboxWindow) ? ECollisionEnabled::NoCollision : CollisionEnabled);
+    if (bSweep && !IsActorTickEnabled() && BoxTraceStart && BoxTraceEnd)
+    {
+        GetBladeSegment(LastBladeStart, LastBladeEnd);
+    }
+    SetActorTickEnabled(bSweep);
+
+    if (bOpen != bCollisionWindowOpen)
+    {
+        bCollisionWindowOpen = bOpen;
+        FEclipseLiveCounters::AddActiveWeaponWindows(bOpen ? 1 : -1);
+    }
+}
+
+EWeaponHitMode AWeapon::GetEffectiveHitMode() const
+{
+    switch (GEclipseWeaponHitModeOverride)
+    {
+    case 0: return EWeaponHitMode::Overlap;
+    case 1: return EWeaponHitMode::Continuous;
+    case 2: return EWeaponHitMode::Hitbox;
+    default: return HitMode;
+    }
+}
+
+bool AWeapon::SetHitboxBladeActive(bool bActive)
+{
+    const ICombatant* Combatant = GetOwnerCombatant();
+    UHitboxComponent* Hitboxes = Combatant ? Combatant->GetHitboxes() : nullptr;
+    if (!Hitboxes)
     {
         return false;
     }
 
-    const FVector Start = BoxTraceStart->GetComponentLocation();
-    const FVector End = BoxTraceEnd->GetComponentLocation();
-    const FVector BoxHalfSize = FVector(5.f, 5.f, 5.f);
+    if (bActive)
+    {
+        FVector BladeStart;
+        FVector BladeEnd;
+        GetBladeLocalSegment(BladeStart, BladeEnd);
+        Hitboxes->ActivateBlade(GetRootComponent(), BladeStart, BladeEnd, BladeHalfThickness, Damage, this);
+    }
+    else
+    {
+        Hitboxes->DeactivateBlade();
+    }
+    return true;
+}
 
-    TArray<AActor*> ActorsToIgnore;
-    ActorsToIgnore.Add(this);
-    // Also ignore the weapon owner and anything attached to the owner to prevent self-hits
-    if (AActor* OwnerActor = GetOwner())
+EWeaponTraceMode AWeapon::GetEffectiveTraceMode() const
+{
+    if (GEclipseWeaponTraceModeOverride >= 0)
     {
-        ActorsToIgnore.Add(OwnerActor);
+        return GEclipseWeaponTraceModeOverride == 0 ? EWeaponTraceMode::Blocking : EWeaponTraceMode::Async;
+    }
+    return TraceMode;
+}
 
-        // Collect all actors attached to the owner recursively (e.g., mesh, sockets, child actors)
-        TSet<AActor*> RecursiveAttached;
-        GatherAttachedActorsRecursive(OwnerActor, RecursiveAttached);
-        for (AActor* AttachedActor : RecursiveAttached)
-        {
-            if (AttachedActor && AttachedActor != OwnerActor)
-            {
-                ActorsToIgnore.Add(AttachedActor);
-            }
-        }
+bool AWeapon::BoxTrace(UPrimitiveComponent* Target, FHitResult& OutHit)
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponBoxTrace);
+    ECLIPSE_ALLOC_SCOPE(WeaponBoxTrace);
+
+    if (!BoxTraceStart || !BoxTraceEnd || !Target)
+    {
+        return false;
     }
 
-    return UKismetSystemLibrary::BoxTraceSingle(
-        this,
-        Start,
-        End,
-        BoxHalfSize,
-        BoxTraceStart->GetComponentRotation(),
-        ETraceTypeQuery::TraceTypeQuery1,
-        false,
-        ActorsToIgnore,
-        EDrawDebugTrace::None,
-        OutHit,
-        true
-    );
+    const FVector Start = BoxTraceStart->GetComponentLocation();
+    const FVector End = BoxTraceEnd->GetComponentLocation();
+    const FVector BoxHalfSize = FVector(BladeTraceHalfSize);
+
+    // Only the overlapped capsule can be hit, so test it alone instead of the scene
+    INC_DWORD_STAT(STAT_EclipseTraces);
+    FEclipseLiveCounters::CountTrace();
+    const bool bHit = Target->SweepComponent(OutHit, Start, End, BoxTraceStart->GetComponentQuat(), FCollisionShape::MakeBox(BoxHalfSize));
+
+    ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::BoxTrace, GetOwner(), OutHit.GetActor(), bHit ? 1.f : 0.f,
+        bHit ? OutHit.ImpactPoint : End);
+    return bHit;
 }
 
 void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponOnBoxOverlap);
+    ECLIPSE_PERF_BUDGET(WeaponOnBoxOverlap, 60.0);
+    LLM_SCOPE_BYTAG(Eclipse_Combat);
+    ECLIPSE_ALLOC_SCOPE(WeaponOverlapQuery);
+    INC_DWORD_STAT(STAT_EclipseOverlaps);
+    FEclipseLiveCounters::CountOverlap();
+    FEclipseCollision::CountOverlapCallback();
+
     // Check if we have a valid actor and it's not ourselves
     if (!OtherActor || OtherActor == this)
     {
@@ -108,191 +258,436 @@ void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherAct
         return;
     }
 
-    // Early-out if owner is not in Attacking action state
-    if (const AMyCharacter* OwnerChar = Cast<AMyCharacter>(OwnerActor))
-    {
-        if (OwnerChar->GetActionState() != EActionState::EAS_Attacking)
-        {
-            return;
-        }
-    }
-    else if (const AEnemy* OwnerEnemy = Cast<AEnemy>(OwnerActor))
+    ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::WeaponOverlap, OwnerActor, OtherActor, 0.f, OtherActor->GetActorLocation());
+
+    if (!IsOwnerAttacking() || !CanHit(OwnerActor, OtherActor, OtherComp))
     {
-        if (OwnerEnemy->ActionState != AEnemy::EActionState::EAS_Attacking)
-        {
-            return;
-        }
+        return;
     }
 
-    // Check if the other actor is our owner (prevent self-damage)
-    if (OtherActor == OwnerActor)
+    ECLIPSE_LATENCY_MARK(OwnerActor, FirstContact);
+
+    if (bAsyncWindow)
     {
+        // The async trace buffers belong to the world, so stop counting before the request
+        ECLIPSE_ALLOC_SCOPE_END(WeaponOverlapQuery);
+        RequestAsyncBoxTrace();
         return;
     }
 
-    // Ignore anything attached to the same owner (e.g., owner's mesh, child actors, equipment)
-    if (OwnerActor)
+    // Capsule first, then the victim's hit zones along the same blade segment
+    FHitResult BoxHit;
+    FHitZoneResult Zone;
+    const FVector BladeStart = BoxTraceStart->GetComponentLocation();
+    const FVector BladeEnd = BoxTraceEnd->GetComponentLocation();
+    if (BoxTrace(OtherComp, BoxHit)
+        && UHurtboxComponent::ConfirmHit(OtherActor, BladeStart, BladeEnd, BladeStart, BladeEnd, BladeTraceHalfSize, BoxHit.ImpactPoint, Zone)
+        && TryRecordHit(OwnerActor, OtherActor))
     {
-        // If the other actor is attached to our owner, ignore
-        if (OtherActor->IsAttachedTo(OwnerActor))
-        {
-            return;
-        }
-        // If our owner is attached to the other actor (rare), also ignore
-        if (OwnerActor->IsAttachedTo(OtherActor))
-        {
-            return;
-        }
-        // If the overlapping component belongs to our owner (component-level self overlap), ignore
-        if (OtherComp && OtherComp->GetOwner() == OwnerActor)
-        {
-            return;
-        }
+        // Damage, hit reactions and effects allocate in engine code; only the query above must be allocation free
+        ECLIPSE_ALLOC_SCOPE_END(WeaponOverlapQuery);
 
-        // If OtherActor is any descendant attachment of our owner, ignore
-        TSet<AActor*> RecursiveAttached;
-        GatherAttachedActorsRecursive(OwnerActor, RecursiveAttached);
-        if (RecursiveAttached.Contains(OtherActor))
-        {
-            return;
-        }
+        ApplyHit(OwnerActor, OtherActor, Zone);
     }
+}
 
-    // Check if we've already hit this actor in this attack
-    if (HitActors.Contains(OtherActor))
+void AWeapon::SweepBlade()
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponSweepBlade);
+    ECLIPSE_PERF_BUDGET(WeaponSweepBlade, 60.0);
+    LLM_SCOPE_BYTAG(Eclipse_Combat);
+    ECLIPSE_ALLOC_SCOPE(WeaponSweepBlade);
+
+    AActor* OwnerActor = GetOwner();
+    if (!OwnerActor || !BoxTraceStart || !BoxTraceEnd)
     {
         return;
     }
 
-    // If our owner is a character, also de-duplicate against their per-attack list
-    if (OwnerActor)
+    FVector CurrentBladeStart;
+    FVector CurrentBladeEnd;
+    GetBladeSegment(CurrentBladeStart, CurrentBladeEnd);
+    const FVector PreviousBladeStart = LastBladeStart;
+    const FVector PreviousBladeEnd = LastBladeEnd;
+    LastBladeStart = CurrentBladeStart;
+    LastBladeEnd = CurrentBladeEnd;
+
+    if (!IsOwnerAttacking())
     {
-        if (AMyCharacter* OwnerChar = Cast<AMyCharacter>(OwnerActor))
-        {
-            if (OwnerChar->HasAlreadyHit(OtherActor))
-            {
-                return;
-            }
-        }
-        else if (AEnemy* OwnerEnemy = Cast<AEnemy>(OwnerActor))
-        {
-            if (OwnerEnemy->HasAlreadyHit(OtherActor))
-            {
-                return;
-            }
-        }
+        return;
     }
 
-    FHitResult BoxHit;
-    bool bHit = BoxTrace(BoxHit);
+    // Enough steps that neither end of the blade moves more than SweepMaxStepDistance per step, so a
+    // 30 Hz frame sweeps the same volume as several 120 Hz frames would
+    const float Travel = FMath::Max(FVector::Dist(PreviousBladeStart, CurrentBladeStart), FVector::Dist(PreviousBladeEnd, CurrentBladeEnd));
+    const int32 NumSteps = FMath::Clamp(FMath::Max(SweepSubsteps, FMath::CeilToInt(Travel / FMath::Max(SweepMaxStepDistance, 1.f))), 1, MaxSweepSubsteps);
+
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(EclipseWeaponSweepBlade), false);
+    Params.bReturnPhysicalMaterial = true;
+    Params.AddIgnoredActors(GetOwnerIgnoreActors());
 
-    if (bHit && BoxHit.GetActor())
+    // Same targets the weapon box overlaps: hurtboxes through the Weapon channel, or every Pawn component with legacy collision
+    const bool bLegacyCollision = FEclipseCollision::UseLegacyProfiles();
+    const FCollisionObjectQueryParams ObjectParams(ECC_Pawn);
+
+    if (bAsyncWindow)
+    {
+        // The async trace buffers belong to the world, so stop counting before the requests
+        ECLIPSE_ALLOC_SCOPE_END(WeaponSweepBlade);
+    }
+
+    SweepCandidates.Reset();
+    FVector StepStart = PreviousBladeStart;
+    FVector StepEnd = PreviousBladeEnd;
+    for (int32 Step = 1; Step <= NumSteps; ++Step)
     {
-        // Extra safety: ignore owner and attachments from trace result as well
-        if (OwnerActor)
+        const float Alpha = static_cast<float>(Step) / NumSteps;
+        const FVector NextStart = FMath::Lerp(PreviousBladeStart, CurrentBladeStart, Alpha);
+        const FVector NextEnd = FMath::Lerp(PreviousBladeEnd, CurrentBladeEnd, Alpha);
+
+        // One box covering the whole blade, oriented along the blade halfway through the step
+        const FVector Axis = ((StepEnd - StepStart) + (NextEnd - NextStart)) * 0.5f;
+        const float HalfLength = Axis.Size() * 0.5f + BladeHalfThickness;
+        const FCollisionShape BladeShape = FCollisionShape::MakeBox(FVector(HalfLength, BladeHalfThickness, BladeHalfThickness));
+        const FQuat BladeRotation = Axis.IsNearlyZero() ? BoxTraceStart->GetComponentQuat() : FRotationMatrix::MakeFromX(Axis).ToQuat();
+
+        INC_DWORD_STAT(STAT_EclipseTraces);
+        FEclipseLiveCounters::CountTrace();
+        if (bAsyncWindow)
         {
-            if (BoxHit.GetActor() == OwnerActor || BoxHit.GetActor()->IsAttachedTo(OwnerActor) || OwnerActor->IsAttachedTo(BoxHit.GetActor()))
+            // Resolved by OnAsyncTraceDone at the start of next frame
+            if (bLegacyCollision)
             {
-                return;
+                GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, (StepStart + StepEnd) * 0.5f, (NextStart + NextEnd) * 0.5f,
+                    BladeRotation, ObjectParams, BladeShape, Params, &AsyncTraceDelegate, WindowSerial);
             }
-
-            TSet<AActor*> RecursiveAttached;
-            GatherAttachedActorsRecursive(OwnerActor, RecursiveAttached);
-            if (RecursiveAttached.Contains(BoxHit.GetActor()))
+            else
             {
-                return;
+                GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Multi, (StepStart + StepEnd) * 0.5f, (NextStart + NextEnd) * 0.5f,
+                    BladeRotation, FEclipseCollision::WeaponChannel, BladeShape, Params, FCollisionResponseParams::DefaultResponseParam,
+                    &AsyncTraceDelegate, WindowSerial);
             }
+            StepStart = NextStart;
+            StepEnd = NextEnd;
+            continue;
+        }
+
+        if (bLegacyCollision)
+        {
+            GetWorld()->SweepMultiByObjectType(SweepStepHits, (StepStart + StepEnd) * 0.5f, (NextStart + NextEnd) * 0.5f,
+                BladeRotation, ObjectParams, BladeShape, Params);
+        }
+        else
+        {
+            GetWorld()->SweepMultiByChannel(SweepStepHits, (StepStart + StepEnd) * 0.5f, (NextStart + NextEnd) * 0.5f,
+                BladeRotation, FEclipseCollision::WeaponChannel, BladeShape, Params);
         }
 
-        // Add this actor to our hit list to prevent multiple hits
-        HitActors.Add(OtherActor);
-        if (OwnerActor)
+        for (const FHitResult& StepHit : SweepStepHits)
         {
-            if (AMyCharacter* OwnerChar = Cast<AMyCharacter>(OwnerActor))
+            AActor* HitActor = StepHit.GetActor();
+            if (!HitActor || !CanHit(OwnerActor, HitActor, StepHit.GetComponent()))
             {
-                OwnerChar->RecordHit(OtherActor);
+                continue;
             }
-            else if (AEnemy* OwnerEnemy = Cast<AEnemy>(OwnerActor))
+
+            // The capsule was hit; the hit zones are tested against the blade's whole movement this frame.
+            // Recording here also keeps an actor found by several sub-steps from being queued twice
+            FHitZoneResult Zone;
+            if (UHurtboxComponent::ConfirmHit(HitActor, PreviousBladeStart, PreviousBladeEnd, CurrentBladeStart, CurrentBladeEnd,
+                    BladeHalfThickness, StepHit.ImpactPoint, Zone)
+                && TryRecordHit(OwnerActor, HitActor))
             {
-                OwnerEnemy->RecordHit(OtherActor);
+                SweepCandidates.Add({ HitActor, Zone });
             }
         }
-        
-        // Apply damage to the hit actor
-        AController* DamageInstigatorController = nullptr;
-        if (APawn* InstPawn = GetInstigator())
-        {
-            DamageInstigatorController = InstPawn->GetController();
-        }
-        else if (APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+
+        StepStart = NextStart;
+        StepEnd = NextEnd;
+    }
+
+    ECLIPSE_ALLOC_SCOPE_END(WeaponSweepBlade);
+
+    for (const FBladeHit& Candidate : SweepCandidates)
+    {
+        ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::BoxTrace, OwnerActor, Candidate.Victim, 1.f, Candidate.Zone.ImpactPoint);
+        ECLIPSE_LATENCY_MARK(OwnerActor, FirstContact);
+        ApplyHit(OwnerActor, Candidate.Victim, Candidate.Zone);
+    }
+}
+
+void AWeapon::GetBladeSegment(FVector& OutStart, FVector& OutEnd) const
+{
+    // Dedicated servers and enemies whose pose isn't evaluated follow the baked path instead of the frozen sockets
+    if (const ICombatant* Combatant = GetOwnerCombatant())
+    {
+        if (Combatant->GetBakedAttackSegment(UAttackTrajectoryAsset::BladeTrackName, OutStart, OutEnd))
         {
-            DamageInstigatorController = OwnerPawn->GetController();
+            return;
         }
+    }
+
+    OutStart = BoxTraceStart->GetComponentLocation();
+    OutEnd = BoxTraceEnd->GetComponentLocation();
+}
 
-        UGameplayStatics::ApplyDamage(
-            BoxHit.GetActor(),
-            Damage,
-            DamageInstigatorController,
-            this,
-            UDamageType::StaticClass()
-        );
+void AWeapon::GetBladeLocalSegment(FVector& OutStart, FVector& OutEnd) const
+{
+    OutStart = BoxTraceStart ? BoxTraceStart->GetRelativeLocation() : FVector::ZeroVector;
+    OutEnd = BoxTraceEnd ? BoxTraceEnd->GetRelativeLocation() : FVector::ZeroVector;
+}
+
+void AWeapon::RequestAsyncBoxTrace()
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponBoxTrace);
 
-        // Handle hit interface if implemented
-        if (IHitInterface* HitInterface = Cast<IHitInterface>(BoxHit.GetActor()))
+    if (!BoxTraceStart || !BoxTraceEnd)
+    {
+        return;
+    }
+
+    // Same box as BoxTrace; the scene is queried because the overlapped component can't be swept off the game thread.
+    // Capsules only overlap the Weapon channel, so this is a multi sweep
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(EclipseWeaponBoxTrace), false);
+    Params.AddIgnoredActors(GetOwnerIgnoreActors());
+
+    const FVector Start = BoxTraceStart->GetComponentLocation();
+    const FVector End = BoxTraceEnd->GetComponentLocation();
+    const FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector(BladeTraceHalfSize));
+
+    INC_DWORD_STAT(STAT_EclipseTraces);
+    FEclipseLiveCounters::CountTrace();
+    if (FEclipseCollision::UseLegacyProfiles())
+    {
+        GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, BoxTraceStart->GetComponentQuat(),
+            FCollisionObjectQueryParams(ECC_Pawn), BoxShape, Params, &AsyncTraceDelegate, WindowSerial);
+    }
+    else
+    {
+        GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Multi, Start, End, BoxTraceStart->GetComponentQuat(),
+            FEclipseCollision::WeaponChannel, BoxShape, Params, FCollisionResponseParams::DefaultResponseParam,
+            &AsyncTraceDelegate, WindowSerial);
+    }
+}
+
+void AWeapon::OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponAsyncTraceDone);
+    LLM_SCOPE_BYTAG(Eclipse_Combat);
+
+    // Results from an earlier window must not land in the current swing
+    AActor* OwnerActor = GetOwner();
+    if (!OwnerActor || TraceDatum.UserData != WindowSerial)
+    {
+        return;
+    }
+
+    // Hits are checked again here: the swing may have hit the same actor through another trace since
+    for (const FHitResult& Hit : TraceDatum.OutHits)
+    {
+        AActor* HitActor = Hit.GetActor();
+        if (HitActor && CanHit(OwnerActor, HitActor, Hit.GetComponent()) && TryRecordHit(OwnerActor, HitActor))
         {
-            HitInterface->GetHit(BoxHit.ImpactPoint);
+            // The blade has moved on since the trace, so the nearest zone to the impact stands in for a narrow phase
+            FHitZoneResult Zone;
+            UHurtboxComponent::ClassifyHit(HitActor, Hit.ImpactPoint, Zone);
+
+            ECLIPSE_RECORD_COMBAT_EVENT(ECombatEventType::BoxTrace, OwnerActor, HitActor, 1.f, Hit.ImpactPoint);
+            ECLIPSE_LATENCY_MARK(OwnerActor, FirstContact);
+            ApplyHit(OwnerActor, HitActor, Zone);
         }
+    }
+}
 
-        // Set the hit enemy as the targeted enemy for the HUD if the attacker is a player
-        if (APlayerController* PlayerController = Cast<APlayerController>(DamageInstigatorController))
+bool AWeapon::IsOwnerAttacking() const
+{
+    const ICombatant* Combatant = GetOwnerCombatant();
+    return !Combatant || Combatant->IsAttacking();
+}
+
+bool AWeapon::CanHit(AActor* OwnerActor, AActor* HitActor, const UPrimitiveComponent* HitComponent)
+{
+    // Ignore our owner and its attachment hierarchy (owner's mesh, child actors, equipment, attach parents)
+    if (GetOwnerIgnoreActors().Contains(HitActor))
+    {
+        return false;
+    }
+
+    // If the overlapping component belongs to our owner (component-level self overlap), ignore
+    if (HitComponent && HitComponent->GetOwner() == OwnerActor)
+    {
+        return false;
+    }
+
+    // Check if this swing has already hit this actor (also covers the owner's kicks)
+    const uint32 SwingId = GetSwingId();
+    IHitInterface* HitInterface = Cast<IHitInterface>(HitActor);
+    if (const FCombatHitLedger* Ledger = HitInterface ? HitInterface->GetHitLedger() : nullptr)
+    {
+        return !Ledger->HasHit(OwnerActor->GetUniqueID(), SwingId);
+    }
+    return UntrackedHitsSwingId != SwingId || !UntrackedHits.Contains(HitActor);
+}
+
+bool AWeapon::TryRecordHit(AActor* OwnerActor, AActor* HitActor)
+{
+    const uint32 SwingId = GetSwingId();
+    IHitInterface* HitInterface = Cast<IHitInterface>(HitActor);
+    if (FCombatHitLedger* Ledger = HitInterface ? HitInterface->GetHitLedger() : nullptr)
+    {
+        return Ledger->TryRecordHit(OwnerActor->GetUniqueID(), SwingId);
+    }
+
+    if (UntrackedHitsSwingId != SwingId)
+    {
+        UntrackedHits.Reset();
+        UntrackedHitsSwingId = SwingId;
+    }
+    if (UntrackedHits.Contains(HitActor))
+    {
+        return false;
+    }
+    UntrackedHits.Add(HitActor);
+    return true;
+}
+
+uint32 AWeapon::GetSwingId() const
+{
+    if (const ICombatant* Combatant = GetOwnerCombatant())
+    {
+        return Combatant->GetSwingId();
+    }
+    return WindowSwingId;
+}
+
+void AWeapon::ApplyHit(AActor* OwnerActor, AActor* HitActor, const FHitZoneResult& Zone)
+{
+    // Damage, reaction and HUD are applied by the resolution subsystem at the end of the frame
+    FCombatHitCandidate Candidate;
+    Candidate.Attacker = OwnerActor;
+    Candidate.Victim = HitActor;
+    Candidate.DamageCauser = this;
+    if (APawn* InstPawn = GetInstigator())
+    {
+        Candidate.InstigatorController = InstPawn->GetController();
+    }
+    else if (APawn* OwnerPawn = Cast<APawn>(OwnerActor))
+    {
+        Candidate.InstigatorController = OwnerPawn->GetController();
+    }
+    Candidate.Damage = Damage * Zone.DamageMultiplier;
+    Candidate.ImpactPoint = Zone.ImpactPoint;
+    UCombatResolutionSubsystem::QueueHit(this, Candidate);
+}
+
+void AWeapon::NotifyAttachmentsChanged(AActor* OwnerActor)
+{
+    if (!OwnerActor)
+    {
+        return;
+    }
+
+    // Only weapons carried by this owner can have it in their ignore list
+    TArray<AActor*> Attached;
+    OwnerActor->GetAttachedActors(Attached, true, true);
+    for (AActor* AttachedActor : Attached)
+    {
+        if (AWeapon* Weapon = Cast<AWeapon>(AttachedActor))
         {
-            if (AEnemy* HitEnemy = Cast<AEnemy>(BoxHit.GetActor()))
-            {
-                if (AMainHUD* MainHUD = Cast<AMainHUD>(PlayerController->GetHUD()))
-                {
-                    MainHUD->SetTargetedEnemy(HitEnemy);
-                }
-            }
+            Weapon->bIgnoreActorsDirty = true;
         }
     }
 }
 
-void AWeapon::OnBoxEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+uint32 AWeapon::GetAttachmentSignature(const AActor* OwnerActor)
 {
-    // Remove from per-weapon hit list so repeated valid hits can register across separate swings
-    if (OtherActor)
+    const USceneComponent* Root = OwnerActor ? OwnerActor->GetRootComponent() : nullptr;
+    if (!Root)
     {
-        HitActors.Remove(OtherActor);
+        return 0;
     }
+
+    // Covers actors attached to the root or to a mesh socket, and the owner mounting or leaving a parent
+    uint32 Signature = HashCombineFast(GetTypeHash(Root->GetAttachParent()), Root->GetAttachChildren().Num());
+    for (const USceneComponent* Child : Root->GetAttachChildren())
+    {
+        if (Child)
+        {
+            Signature = HashCombineFast(Signature, Child->GetAttachChildren().Num());
+        }
+    }
+    return Signature;
 }
 
-void AWeapon::GatherAttachedActorsRecursive(AActor* RootActor, TSet<AActor*>& OutAttached)
+const TArray<AActor*>& AWeapon::GetOwnerIgnoreActors()
 {
-    if (!RootActor || OutAttached.Contains(RootActor))
+    AActor* OwnerActor = GetOwner();
+    const uint32 Signature = GetAttachmentSignature(OwnerActor);
+    if (!bIgnoreActorsDirty && IgnoreActorsOwner.Get() == OwnerActor && IgnoreActorsSignature == Signature)
     {
-        return;
+        return OwnerIgnoreActors;
+    }
+
+    OwnerIgnoreActors.Reset();
+    OwnerIgnoreActors.Add(this);
+    if (OwnerActor)
+    {
+        OwnerIgnoreActors.Add(OwnerActor);
+
+        // Actors the owner is attached to (e.g. riding a mount)
+        for (AActor* Parent = OwnerActor->GetAttachParentActor(); Parent; Parent = Parent->GetAttachParentActor())
+        {
+            OwnerIgnoreActors.AddUnique(Parent);
+        }
+
+        // Everything attached to the owner recursively (mesh, sockets, child actors, other equipment)
+        GatherAttachedActors(OwnerActor, OwnerIgnoreActors);
     }
 
-    TArray<AActor*> DirectChildren;
-    RootActor->GetAttachedActors(DirectChildren);
-    for (AActor* Child : DirectChildren)
+    // Drops overlap pairs with the owner's meshes and equipment inside the physics query instead of in CanHit
+    if (WeaponBox)
     {
-        if (Child && !OutAttached.Contains(Child))
+        WeaponBox->ClearMoveIgnoreActors();
+        for (AActor* IgnoreActor : OwnerIgnoreActors)
         {
-            OutAttached.Add(Child);
-            GatherAttachedActorsRecursive(Child, OutAttached);
+            WeaponBox->IgnoreActorWhenMoving(IgnoreActor, true);
         }
     }
+
+    IgnoreActorsOwner = OwnerActor;
+    IgnoreActorsSignature = Signature;
+    bIgnoreActorsDirty = false;
+    return OwnerIgnoreActors;
+}
+
+void AWeapon::GatherAttachedActors(AActor* RootActor, TArray<AActor*>& OutAttached)
+{
+    ECLIPSE_SCOPE_CYCLE_COUNTER(STAT_EclipseWeaponGatherAttached);
+
+    if (RootActor)
+    {
+        // Appends without resetting; the engine walks the attachment tree with an inline stack
+        RootActor->GetAttachedActors(OutAttached, false, true);
+    }
 }
 
 void AWeapon::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (bCollisionWindowOpen && bContinuousWindow)
+	{
+		SweepBlade();
+	}
+
 }
 
 void AWeapon::ClearHitActors()
 {
-	HitActors.Empty();
+	if (ICombatant* Combatant = GetOwnerCombatant())
+	{
+		Combatant->StartNewSwing();
+	}
+	WindowSwingId = FCombatHitLedger::NewSwingId();
 }
 
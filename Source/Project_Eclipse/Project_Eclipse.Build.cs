@@ -10,7 +10,7 @@ public class Project_Eclipse : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "UMG", "AIModule", "EnhancedInput", "HairStrandsCore" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "AssetRegistry", "Niagara" });
 
 		// Uncomment if you are using Slate UI`
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
@@ -2,5 +2,41 @@
 
 #include "Project_Eclipse.h"
 #include "Modules/ModuleManager.h"
+#include "Diagnostics/CombatFlightRecorder.h"
+#include "Diagnostics/EclipsePerfBudget.h"
+#include "Diagnostics/EclipseAllocTracking.h"
+#include "Diagnostics/EclipseLiveCounters.h"
+#include "Misc/CommandLine.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Project_Eclipse, "Project_Eclipse" );
+class FProjectEclipseModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if ECLIPSE_WITH_ALLOC_TRACKING
+		if (FParse::Param(FCommandLine::Get(), TEXT("EclipseAllocTracking")))
+		{
+			FEclipseAllocTracking::Install();
+		}
+#endif
+#if ECLIPSE_WITH_PERF_BUDGETS
+		if (FParse::Param(FCommandLine::Get(), TEXT("EclipsePerfBudgets")))
+		{
+			FEclipsePerfBudgets::SetEnabled(true);
+		}
+#endif
+		if (FParse::Param(FCommandLine::Get(), TEXT("EclipseLiveCounters")))
+		{
+			FEclipseLiveCounters::Start();
+		}
+	}
+
+	virtual void ShutdownModule() override
+	{
+		// Final flush of the combat flight recorder before the engine tears down the file system
+		FCombatFlightRecorder::Get().Shutdown();
+		FEclipseLiveCounters::Stop();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FProjectEclipseModule, Project_Eclipse, "Project_Eclipse" );
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AttackTrajectoryAsset.generated.h"
+
+class UAnimMontage;
+class AWeapon;
+
+// A segment attached to a bone or socket; the bake stores both ends per frame
+USTRUCT()
+struct FAttackTrajectoryTrackSource
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FName TrackName;
+
+	// Skeleton socket, or a bone when no socket has this name
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FName Socket;
+
+	// Segment ends in socket space
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FVector LocalStart = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	FVector LocalEnd = FVector::ZeroVector;
+
+	// Take LocalStart/LocalEnd from the weapon's BoxTraceStart/BoxTraceEnd
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	bool bUseWeaponBlade = false;
+};
+
+USTRUCT()
+struct FAttackTrajectorySection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	FName SectionName;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	float Duration = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	int32 NumFrames = 0;
+
+	// Mesh component space; frame-major, each frame holds start and end of every track
+	UPROPERTY()
+	TArray<FVector3f> Points;
+};
+
+/**
+ * Weapon and limb paths baked from the sections of an attack montage.
+ * Sampling a section only needs the time since it started and the mesh component transform, so hit
+ * detection can follow the attack on dedicated servers and for enemies whose pose is not evaluated.
+ * Bake from the asset's details panel, or for every asset with -run=BakeAttackTrajectories.
+ */
+UCLASS(BlueprintType)
+class PROJECT_ECLIPSE_API UAttackTrajectoryAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UAttackTrajectoryAsset();
+
+	// Track the default sources bake from the weapon blade
+	static const FName BladeTrackName;
+
+	int32 FindTrack(FName TrackName) const { return TrackNames.IndexOfByKey(TrackName); }
+	const FAttackTrajectorySection* FindSection(FName SectionName) const;
+
+	// Segment of a track at a time in the section, in mesh component space; false past the end of the section
+	bool SampleSegment(const FAttackTrajectorySection& Section, int32 TrackIndex, float Time, FVector& OutStart, FVector& OutEnd) const;
+
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	TObjectPtr<UAnimMontage> Montage;
+
+	// Supplies the blade for tracks with bUseWeaponBlade
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	TSubclassOf<AWeapon> WeaponClass;
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	TArray<FName> SectionNames;
+
+	UPROPERTY(EditAnywhere, Category = "Bake")
+	TArray<FAttackTrajectoryTrackSource> TrackSources;
+
+	UPROPERTY(EditAnywhere, Category = "Bake", meta = (ClampMin = "10", ClampMax = "240"))
+	float SampleRate = 60.f;
+#endif
+
+#if WITH_EDITOR
+	// Samples every section of Montage and replaces the baked data
+	UFUNCTION(CallInEditor, Category = "Bake")
+	void Bake();
+
+	bool BakeFromMontage(FString& OutError);
+#endif
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	TArray<FName> TrackNames;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	float SampleInterval = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	TArray<FAttackTrajectorySection> Sections;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeAttackTrajectoriesCommandlet.generated.h"
+
+/**
+ * Re-bakes and saves every UAttackTrajectoryAsset in the project.
+ *   UnrealEditor-Cmd Project_Eclipse.uproject -run=BakeAttackTrajectories
+ * Returns 1 if any asset fails to bake or save.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UBakeAttackTrajectoriesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBakeAttackTrajectoriesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
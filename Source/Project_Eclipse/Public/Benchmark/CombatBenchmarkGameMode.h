@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MyGameMode.h"
+#include "CombatBenchmarkGameMode.generated.h"
+
+class AEnemy;
+class AMyCharacter;
+class AWeapon;
+
+/**
+ * Headless combat stress benchmark.
+ * Spawns a ring of enemies (each with its WeaponClass weapon) around the player, drives them through
+ * patrol, chase, attack and Die() cycles and writes game-thread frame-time percentiles to CSV.
+ *
+ * Run on a map with a nav mesh, e.g.:
+ *   Project_Eclipse /Game/Project_Eclipse?game=/Script/Project_Eclipse.CombatBenchmarkGameMode -nullrhi -unattended
+ *
+ * Command line overrides:
+ *   -EclipseBenchEnemies=N -EclipseBenchWarmup=Seconds -EclipseBenchDuration=Seconds
+ *   -EclipseBenchEnemyClass=/Game/Path/BP_Enemy.BP_Enemy_C -EclipseBenchCSV=Path/To/File.csv
+ *   -EclipsePerfBudgets  check ECLIPSE_PERF_BUDGET scopes after warmup; the run exits with code 1 on a violation
+ *   -EclipseAllocTracking  fail the run if any ECLIPSE_ALLOC_SCOPE allocates after warmup
+ *   -EclipseLiveCounters  publish live counters and fail the run if they disagree with the world
+ * Weapon hit/trace modes can be switched with -ExecCmds="Eclipse.Weapon.HitMode 1, Eclipse.Weapon.TraceMode 1";
+ * the player weapon's modes are written with the results.
+ * Overlap callbacks per frame are written too; compare against a run with -ExecCmds="Eclipse.Collision.LegacyProfiles 1".
+ * Enemies are spawned through the encounter director's budgeted queue, so the first wave and replacements are
+ * spread over frames (-ExecCmds="Eclipse.Spawn.BudgetMs 1000" spawns them all at once for comparison).
+ * Enemies and weapons come from UCombatActorPoolSubsystem; -ExecCmds="Eclipse.Pool.Enabled 0" spawns and destroys them instead.
+ * Enemy weapons are components unless -ExecCmds="Eclipse.Weapon.ComponentMode 0" gives each enemy an AWeapon actor.
+ * Player attack latency (input to impact) is appended to CombatLatency.csv next to the results file.
+ * Startup is measured too: launch to playable (first wave spawned, combat assets loaded) and the longest frame
+ * around the player's first attack, which only starts once playable. Compare combat asset loading with
+ * -ExecCmds="Eclipse.Assets.Async 0" or "Eclipse.Assets.Prewarm 0".
+ */
+UCLASS(Blueprintable)
+class PROJECT_ECLIPSE_API ACombatBenchmarkGameMode : public AMyGameMode
+{
+	GENERATED_BODY()
+
+public:
+	ACombatBenchmarkGameMode();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnEnemySpawned(AEnemy* Enemy, int32 Tag) override;
+	virtual void OnEnemySpawnFailed(int32 Tag) override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TSubclassOf<AEnemy> EnemyClass;
+
+	// Weapon given to the player; falls back to the player's own WeaponClass
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	TSubclassOf<AWeapon> PlayerWeaponClass;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	int32 NumEnemies = 50;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float SpawnRadius = 1200.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	int32 NumPatrolPoints = 8;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float WarmupSeconds = 5.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float DurationSeconds = 60.f;
+
+	// Each enemy patrols, then chases and attacks the player, then is killed and replaced
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float PatrolSeconds = 4.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float ChaseSeconds = 10.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float CorpseSeconds = 2.f;
+
+	// How often the player swings (0 disables player attacks)
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	float PlayerAttackInterval = 1.5f;
+
+	// Empty means Saved/Benchmarks/CombatBenchmark.csv
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	FString OutputFile;
+
+	// Request engine exit once results are written (always on with -unattended)
+	UPROPERTY(EditDefaultsOnly, Category = "Benchmark")
+	bool bExitWhenDone = false;
+
+private:
+	struct FEnemySlot
+	{
+		TWeakObjectPtr<AEnemy> Enemy;
+		float PhaseTime = 0.f;
+		bool bKilled = false;
+		bool bSpawnQueued = false;
+	};
+
+	void ParseCommandLine();
+	void StartBenchmark(AMyCharacter* Player);
+	void FinishBenchmark();
+
+	// Queues the slot's enemy on the encounter director; OnEnemySpawned fills the slot, OnEnemySpawnFailed frees it to queue again
+	void QueueSlotSpawn(int32 SlotIndex);
+	void EquipPlayerWeapon(AMyCharacter* Player);
+	void TickEnemySlot(FEnemySlot& Slot, int32 SlotIndex, float DeltaSeconds);
+	void KillEnemy(AEnemy* Enemy);
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnEndFrame();
+	void CheckLiveCounters();
+	bool IsPlayable() const;
+
+	static float Percentile(TArray<float>& SortedValues, float Percent);
+	void WriteResults();
+	FString GetWeaponModeLabel() const;
+
+	UPROPERTY()
+	TArray<AActor*> PatrolPoints;
+
+	UPROPERTY()
+	AMyCharacter* PlayerCharacter;
+
+	TArray<FEnemySlot> EnemySlots;
+
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+
+	FDelegateHandle WorldTickStartHandle;
+	FDelegateHandle EndFrameHandle;
+
+	double LastWorldTickStart = 0.0;
+	double WorldTickStart = 0.0;
+	float ElapsedSeconds = 0.f;
+	float PlayerAttackTimer = 0.f;
+
+	int32 Kills = 0;
+	int32 Spawns = 0;
+
+	static constexpr uint64 LiveCounterCheckInterval = 60;
+	int32 LiveCounterMismatches = 0;
+
+	uint64 OverlapCallbacksAtWindowStart = 0;
+
+	// Process start to the first playable frame
+	double LaunchToPlayableMs = -1.0;
+
+	// Longest game thread frame from the player's first attack until FirstAttackWindowSeconds later
+	static constexpr float FirstAttackWindowSeconds = 1.f;
+	float FirstAttackWindowEnd = -1.f;
+	float FirstAttackMaxFrameMs = -1.f;
+
+	bool bStarted = false;
+	bool bFinished = false;
+	bool bBudgetWindowOpen = false;
+};
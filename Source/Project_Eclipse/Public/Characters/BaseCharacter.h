@@ -3,13 +3,21 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Interfaces/HitInterface.h"
+#include "Interfaces/Combatant.h"
+#include "Combat/CombatHitLedger.h"
 #include "BaseCharacter.generated.h"
 
 class AWeapon;
+class UAttackTrajectoryAsset;
 class UAttributeComponent;
+class UCombatAssetSet;
+class UFXSystemAsset;
+class UHitboxComponent;
+class UHurtboxComponent;
+class UWeaponComponent;
 
 UCLASS()
-class PROJECT_ECLIPSE_API ABaseCharacter : public ACharacter, public IHitInterface
+class PROJECT_ECLIPSE_API ABaseCharacter : public ACharacter, public IHitInterface, public ICombatant
 {
 	GENERATED_BODY()
 
@@ -18,10 +26,27 @@ public:
 	ABaseCharacter();
 	virtual void Tick(float DeltaTime);
 	virtual void GetHit(const FVector& ImpactPoint);
+	virtual FCombatHitLedger* GetHitLedger() override { return &HitLedger; }
+	virtual UHurtboxComponent* GetHurtbox() override { return Hurtbox; }
+	virtual ICombatant* AsCombatant() override { return this; }
+
+	//~ ICombatant
+	// Subclasses with an action state override this; others can hit whenever a window is open
+	virtual bool IsAttacking() const override { return true; }
+	virtual uint32 GetSwingId() const override { return SwingId; }
+
+	// World-space segment of a baked track for the section in progress.
+	// False when there is no bake or Eclipse.Combat.BakedTrajectories says the live pose should be used.
+	virtual bool GetBakedAttackSegment(FName TrackName, FVector& OutStart, FVector& OutEnd) const override;
 
 	UFUNCTION(BlueprintCallable)
 	void SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled);
 
+#if WITH_EDITOR
+	// With CombatAssets set, the hard references it replaces must be empty or they still load with the map
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
 
 protected:
 	
@@ -42,24 +67,70 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = Montages)
 	UAnimMontage* HitReactMontage;
 
+	// AttackMontage sections baked to weapon and foot paths, for hit detection without pose evaluation
+	UPROPERTY(EditDefaultsOnly, Category = Montages)
+	UAttackTrajectoryAsset* AttackTrajectories;
+
+	// Attack and hit react montages, hit effects and weapon class as soft references, streamed in when the
+	// character begins play. Loaded assets replace the hard references, which must stay empty when this is set.
+	UPROPERTY(EditDefaultsOnly, Category = "Combat Assets")
+	UCombatAssetSet* CombatAssets;
+
+	// Requests CombatAssets through UCombatAssetSubsystem and applies them once loaded
+	void LoadCombatAssets();
+
+	// Copies the loaded entries of CombatAssets over the hard references
+	virtual void ApplyCombatAssets();
+
+#if WITH_EDITOR
+	// Adds an error when CombatAssets is set and so is the hard reference; false if it did
+	bool ValidateReplacedByCombatAssets(FDataValidationContext& Context, const UObject* HardReference, const TCHAR* PropertyName) const;
+#endif
+
+	// Call when an AttackMontage section starts so baked tracks can be sampled by time
+	void BeginAttackTrajectory(FName SectionName);
+
 	void DirectionalHitReact(const FVector& ImpactPoint);
 
+	// Full health, no hits or attack in progress, animation running and the mesh back to no collision.
+	// For characters handed out again by UCombatActorPoolSubsystem.
+	void ResetCombatState();
+
 	UFUNCTION()
 	virtual void OnHitReactMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 
 	UPROPERTY(VisibleAnywhere)
 	UAttributeComponent* Attributes;
 
+	// Blade and limb attack shapes, evaluated together once per frame
+	UPROPERTY(VisibleAnywhere)
+	UHitboxComponent* Hitboxes;
+
+	// Per-bone hit zones behind the capsule
+	UPROPERTY(VisibleAnywhere)
+	UHurtboxComponent* Hurtbox;
+
+	// WeaponClass's mesh and blade on the hand socket, used instead of an AWeapon actor when UsesWeaponComponent
+	UPROPERTY(VisibleAnywhere, Category = "Weapon")
+	UWeaponComponent* WeaponComponent;
+
+	// Equip WeaponClass as WeaponComponent rather than spawning it; Eclipse.Weapon.ComponentMode overrides this
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
+	bool bWeaponAsComponent = false;
+
 public:
 	// Getter for Attributes component
 	FORCEINLINE UAttributeComponent* GetAttributes() const { return Attributes; }
+	FORCEINLINE UCombatAssetSet* GetCombatAssets() const { return CombatAssets; }
+	virtual UHitboxComponent* GetHitboxes() const override { return Hitboxes; }
 
 
 	UPROPERTY(EditAnywhere, Category = Sounds)
 	USoundBase* HitSound;
 
+	// Cascade or Niagara; played through UCombatEffectsSubsystem
 	UPROPERTY(EditAnywhere, Category = VisualEffects)
-	UParticleSystem* HitParticles;
+	UFXSystemAsset* HitParticles;
 
 	// Weapon system
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
@@ -68,16 +139,27 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "Weapon")
 	AWeapon* EquippedWeapon;
 
+	FORCEINLINE UWeaponComponent* GetWeaponComponent() const { return WeaponComponent; }
+	bool UsesWeaponComponent() const;
+
 	// Weapon collision management
-	virtual void EnableWeaponCollision();
-	virtual void DisableWeaponCollision();
-	virtual void ClearWeaponHitActors();
+	virtual void EnableWeaponCollision() override;
+	virtual void DisableWeaponCollision() override;
+
+	// Starts a new attack: hits recorded under the previous swing id no longer block this one
+	virtual void StartNewSwing() override;
 
 	// Hit tracking system
-	UPROPERTY()
-	TArray<AActor*> HitActors;
-	bool HasAlreadyHit(AActor* Other) const { return HitActors.Contains(Other); }
-	void RecordHit(AActor* Other) { if (Other) { HitActors.AddUnique(Other); } }
+	virtual bool HasAlreadyHit(AActor* Other) const override;
+	virtual bool TryRecordHit(AActor* Other) override;
+
+	uint32 SwingId = 0;
+
+	FName ActiveAttackSection;
+	float ActiveAttackStartTime = 0.f;
+
+	// Swings that have landed on this character
+	FCombatHitLedger HitLedger;
 
 
 
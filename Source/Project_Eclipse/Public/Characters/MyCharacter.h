@@ -11,10 +11,11 @@ class USpringArmComponent;
 class UCameraComponent;
 
 class UAnimMontage;
-class UBoxComponent;
 class UCharacter_Overlay;
 class UInputMappingContext;
 class UInputAction;
+struct FInputActionInstance;
+enum class ECombatInputAction : uint8;
 
 UCLASS()
 class PROJECT_ECLIPSE_API AMyCharacter : public ABaseCharacter 
@@ -46,25 +47,22 @@ public:
 
 	FORCEINLINE ECharacterState GetCharacterState() const { return CharacterState; }
 	FORCEINLINE EActionState GetActionState() const { return ActionState; }
+	virtual bool IsAttacking() const override { return ActionState == EActionState::EAS_Attacking; }
 
 	void EnableKickCollision();
 	void DisableKickCollision();
 
 
-	void EnableWeaponCollision();
-	void DisableWeaponCollision();
-
-	// Clear weapon hit actors (call this when starting a new attack)
-	void ClearWeaponHitActors();
-
-	// Query/record hits (used by weapon to avoid double damage if owner routes weapon hits)
-	bool HasAlreadyHit(AActor* Other) const { return HitActors.Contains(Other); }
-	void RecordHit(AActor* Other) { if (Other) { HitActors.AddUnique(Other); } }
+	virtual void EnableWeaponCollision() override;
+	virtual void DisableWeaponCollision() override;
 
 	// Blueprint callable function to set up weapon properly
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	void SetWeaponOwner(AWeapon* Weapon);
 
+	// Runs an input action as if it came from the bound input (used by combat replay)
+	void ApplyInput(ECombatInputAction Action, const FVector2D& Value);
+
 	// DEBUG: Manual weapon collision test
 	UFUNCTION(BlueprintCallable, Category = "Debug")
 	void TestEnableWeaponCollision();
@@ -96,6 +94,9 @@ protected:
 
 
 
+	// All bound input actions come through here so combat replay can record them
+	void HandleInputAction(const FInputActionInstance& Instance, ECombatInputAction Action);
+
 	void Move(const FInputActionValue& Value);
 	void Look(const FInputActionValue& Value);
 	void ControlAnimationRootMotion();
@@ -126,6 +127,12 @@ private:
 	// Helper to play a specific montage section without cycling
 	bool PlayAttackMontageSection(FName SectionName);
 
+	// Attack1/2/3: stamps the input for latency tracking, then tries the section
+	void HandleAttackInput(FName SectionName);
+
+	// Records the transition in the combat flight recorder
+	void SetActionState(EActionState NewState);
+
     // Camera setup
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = "true"))
     USpringArmComponent* CameraBoom;
@@ -133,13 +140,12 @@ private:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = "true"))
     UCameraComponent* ViewCamera;
 
+	// Shapes on the hitbox component
+	static const FName KickLeftShapeName;
+	static const FName KickRightShapeName;
 
-	// Add two box components for both legs
-	UPROPERTY(VisibleAnywhere)
-	UBoxComponent* KickBoxLeft;
-
-	UPROPERTY(VisibleAnywhere)
-	UBoxComponent* KickBoxRight;
+	// Pending delayed start of the kick window; cleared when the window is closed first
+	FTimerHandle KickEnableTimer;
 
 	UPROPERTY(BlueprintReadWrite, meta = (AllowPrivateAccess = "true"))
 	EActionState ActionState = EActionState::EAS_Unoccupied;
@@ -150,8 +156,5 @@ private:
 	ECharacterState CharacterState = ECharacterState::ECS_Unequipped;
 
 	int32 AttackCount = 0;
-
-	UFUNCTION()
-	void OnKickBoxOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 };
 
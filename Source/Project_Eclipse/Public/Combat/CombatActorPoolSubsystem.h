@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatActorPoolSubsystem.generated.h"
+
+class APawn;
+class UActorComponent;
+
+USTRUCT()
+struct FCombatActorPool
+{
+	GENERATED_BODY()
+
+	// Parked, ready to hand out
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Free;
+
+	int32 NumInUse = 0;
+};
+
+// An actor owned by the pool, and what it had running when it was parked
+USTRUCT()
+struct FPooledActorRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UActorComponent>> PausedComponents;
+
+	bool bInUse = false;
+	bool bParked = false;
+	bool bWasHidden = false;
+	bool bCollisionWasEnabled = true;
+	bool bActorTickWasEnabled = false;
+};
+
+/**
+ * Reuses enemies and weapons instead of spawning and destroying them, so wave encounters don't churn actors,
+ * components, physics state and GC. Classes implementing IPooledActor are parked on release: detached, hidden,
+ * with collision and ticking off. They are handed out again with their IPooledActor reset hooks.
+ * Acquisition is two-phase like SpawnActorDeferred: set the actor up, then FinishAcquire. A parked actor
+ * has already begun play, so anything BeginPlay reads must be applied by its OnAcquiredFromPool.
+ * Other classes, worlds without the subsystem and Eclipse.Pool.Enabled 0 fall back to spawn and destroy.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UCombatActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UCombatActorPoolSubsystem* Get(const UObject* WorldContextObject);
+	static bool IsPoolingEnabled();
+
+	// Spawns parked actors until Count of the class are free, so the first acquisitions don't spawn
+	static void Prewarm(const UObject* WorldContextObject, TSubclassOf<AActor> Class, int32 Count);
+
+	// A free actor of the class moved to Transform, or a deferred spawn when none is free. Call FinishAcquire after setting it up.
+	static AActor* AcquireDeferredActor(const UObject* WorldContextObject, TSubclassOf<AActor> Class, const FTransform& Transform,
+		AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	// Finishes the spawn if there was one, then unparks the actor and runs its OnAcquiredFromPool
+	static void FinishAcquire(AActor* Actor, const FTransform& Transform);
+
+	// Parks a pooled actor for reuse; anything else is destroyed
+	static void Release(AActor* Actor);
+
+	template<class T>
+	static T* AcquireDeferred(const UObject* WorldContextObject, TSubclassOf<T> Class, const FTransform& Transform,
+		AActor* Owner = nullptr, APawn* Instigator = nullptr)
+	{
+		return Cast<T>(AcquireDeferredActor(WorldContextObject, Class, Transform, Owner, Instigator));
+	}
+
+	// AcquireDeferred and FinishAcquire, for actors that need no setup in between
+	template<class T>
+	static T* Acquire(const UObject* WorldContextObject, TSubclassOf<T> Class, const FTransform& Transform,
+		AActor* Owner = nullptr, APawn* Instigator = nullptr)
+	{
+		T* Actor = AcquireDeferred<T>(WorldContextObject, Class, Transform, Owner, Instigator);
+		FinishAcquire(Actor, Transform);
+		return Actor;
+	}
+
+	//~ UWorldSubsystem
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AActor* AcquireFromPool(UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+	AActor* SpawnPooled(UClass* Class, const FTransform& Transform, AActor* Owner, APawn* Instigator, ESpawnActorCollisionHandlingMethod CollisionHandling);
+	void ReturnToPool(AActor* Actor);
+	void Park(AActor* Actor, FPooledActorRecord& Record);
+	void Unpark(AActor* Actor, FPooledActorRecord& Record);
+	void PublishOccupancy() const;
+
+	// Pooled actors destroyed by someone else (level unload, a stray Destroy) leave the pool
+	UFUNCTION()
+	void OnPooledActorDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FCombatActorPool> Pools;
+
+	UPROPERTY()
+	TMap<TObjectPtr<AActor>, FPooledActorRecord> Records;
+};
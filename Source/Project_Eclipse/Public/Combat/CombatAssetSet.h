@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatAssetSet.generated.h"
+
+class UAnimMontage;
+class USoundBase;
+class UFXSystemAsset;
+class AWeapon;
+
+/**
+ * A character class's combat assets as soft references, so maps and character blueprints don't load them.
+ * Every reference is in the "Combat" asset bundle. UCombatAssetSubsystem loads the bundle asynchronously
+ * when the character begins play, or earlier when an encounter is queued, and prewarms it before first use.
+ * Sets are primary assets of type CombatAssetSet (see DefaultGame.ini); unregistered sets load their
+ * references directly.
+ */
+UCLASS(BlueprintType)
+class PROJECT_ECLIPSE_API UCombatAssetSet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FName BundleName;
+
+	// True once every reference that is set has been loaded
+	bool IsLoaded() const;
+
+	// The bundle's references that are set, for loading without the asset manager
+	void GetBundlePaths(TArray<FSoftObjectPath>& OutPaths) const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Montages", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<UAnimMontage> AttackMontage;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Montages", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<UAnimMontage> HitReactMontage;
+
+	// Enemies only
+	UPROPERTY(EditDefaultsOnly, Category = "Montages", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<UAnimMontage> DeathMontage;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Effects", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<USoundBase> HitSound;
+
+	// Cascade or Niagara
+	UPROPERTY(EditDefaultsOnly, Category = "Effects", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<UFXSystemAsset> HitParticles;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon", meta = (AssetBundles = "Combat"))
+	TSoftClassPtr<AWeapon> WeaponClass;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatAssetSubsystem.generated.h"
+
+class ABaseCharacter;
+class UAnimMontage;
+class UCombatAssetSet;
+class USoundBase;
+struct FStreamableHandle;
+
+/**
+ * Loads UCombatAssetSet bundles for the world and keeps them loaded until it ends.
+ * Loads are asynchronous: a set is requested when a character using it begins play (including characters
+ * of a level being streamed in) or, ahead of that, when an encounter is queued. Once a set has loaded,
+ * its montages have a key of every animation decompressed and its sound waves are precached on the audio
+ * device, so the first attack doesn't pay for it. Eclipse.Assets.Async 0 loads synchronously and
+ * Eclipse.Assets.Prewarm 0 skips the prewarm, as baselines. Worlds without the subsystem load synchronously.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UCombatAssetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Loads the set's bundle and runs OnLoaded once it has; at once when it already has
+	static void RequestLoad(const UObject* WorldContextObject, UCombatAssetSet* Set, FSimpleDelegate OnLoaded = FSimpleDelegate());
+
+	// Starts loading the combat assets of a character class, e.g. for enemies about to be spawned
+	UFUNCTION(BlueprintCallable, Category = "Combat Assets", meta = (WorldContext = "WorldContextObject"))
+	static void PreloadCharacterClass(const UObject* WorldContextObject, TSubclassOf<ABaseCharacter> CharacterClass);
+
+	// True when the class has no combat asset set or its load has finished
+	static bool IsCharacterClassReady(const UObject* WorldContextObject, TSubclassOf<ABaseCharacter> CharacterClass);
+
+	// For benchmark results, e.g. "Async+Prewarm"
+	static FString GetLoadingModeLabel();
+
+	//~ UWorldSubsystem
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSetLoad
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TArray<FSimpleDelegate> OnLoaded;
+		bool bLoaded = false;
+	};
+
+	void Load(UCombatAssetSet* Set, FSimpleDelegate OnLoaded);
+	TSharedPtr<FStreamableHandle> StartLoad(UCombatAssetSet* Set);
+	void OnSetLoaded(TWeakObjectPtr<UCombatAssetSet> WeakSet);
+	bool IsSetReady(const UCombatAssetSet* Set) const;
+
+	void Prewarm(const UCombatAssetSet* Set);
+	static void PrewarmMontage(const UAnimMontage* Montage);
+	void PrewarmSound(USoundBase* Sound);
+
+	TMap<TWeakObjectPtr<UCombatAssetSet>, FSetLoad> Loads;
+};
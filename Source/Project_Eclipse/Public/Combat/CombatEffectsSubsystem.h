@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatEffectsSubsystem.generated.h"
+
+class UFXSystemAsset;
+class UFXSystemComponent;
+class USoundBase;
+class USoundConcurrency;
+
+/**
+ * Hit particles and sounds for the whole world, instead of a new component and voice per hit.
+ * Particle systems, Cascade or Niagara, come from the engine's component pools. Same-frame impacts of one effect
+ * within Eclipse.FX.MergeRadius share a single spawn, moved to their centroid. The radius grows with distance
+ * from the nearest local view, and particles past Eclipse.FX.CullDistance (sounds past their attenuation range)
+ * don't play at all. Each effect gets Eclipse.FX.MaxPerFrame spawns a frame, after which impacts merge into the
+ * nearest one, and Eclipse.FX.MaxActive live particle systems. Each sound is limited to Eclipse.FX.MaxVoices
+ * through a concurrency group of its own. Eclipse.FX.Pooled 0 spawns every effect directly, as before, for A/B runs.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UCombatEffectsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Plays through the world's subsystem, or spawns directly when there is none (editor worlds) or pooling is off
+	static void PlayHitEffects(const UObject* WorldContextObject, UFXSystemAsset* Particles, USoundBase* Sound, const FVector& Location);
+
+	//~ UWorldSubsystem
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// One spawn this frame and the impacts merged into it
+	struct FFrameImpact
+	{
+		const UObject* Effect = nullptr;
+		FVector LocationSum = FVector::ZeroVector;
+		int32 Count = 0;
+		TWeakObjectPtr<UFXSystemComponent> Component;
+
+		FVector GetLocation() const { return LocationSum / Count; }
+	};
+
+	void BeginFrame();
+	void PlayParticles(UFXSystemAsset* Particles, const FVector& Location, float ViewDistance);
+	void PlaySound(USoundBase* Sound, const FVector& Location, float ViewDistance);
+
+	// Adds the impact to the nearest spawn of the effect this frame: within the merge radius, or at any distance with bAnyDistance
+	bool TryMerge(const UObject* Effect, const FVector& Location, float ViewDistance, bool bAnyDistance);
+	int32 CountFrameSpawns(const UObject* Effect) const;
+	bool HasActiveRoom(const UFXSystemAsset* Particles);
+	float GetViewDistance(const FVector& Location) const;
+	USoundConcurrency* GetConcurrency(USoundBase* Sound);
+
+	static UFXSystemComponent* SpawnParticles(UWorld* World, UFXSystemAsset* Particles, const FVector& Location, bool bPooled);
+
+	// Impacts nearer than this to a view merge at the base radius
+	static constexpr float FullDetailDistance = 1500.f;
+
+	uint64 Frame = 0;
+	TArray<FFrameImpact> FrameImpacts;
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	// Particle systems spawned per effect that may still be playing
+	TMap<const UFXSystemAsset*, TArray<TWeakObjectPtr<UFXSystemComponent>>> ActiveParticles;
+
+	UPROPERTY()
+	TMap<TObjectPtr<USoundBase>, TObjectPtr<USoundConcurrency>> SoundConcurrency;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-victim record of the last swing each attacker landed on it.
+ * Every attack takes a new id from NewSwingId(), so "already hit this swing" is a lookup in a small
+ * slot table on the victim instead of a search through the attacker's hit list. Nothing is cleared
+ * between swings; a new id simply no longer matches the stored one.
+ * The table holds NumSlots attackers inline and grows past that instead of evicting: the ledger can't
+ * tell whether a swing has ended, and dropping a live one would let it hit the victim again.
+ */
+struct FCombatHitLedger
+{
+	static constexpr int32 NumSlots = 8;
+
+	// Ids start at 1; 0 means "no swing" and never matches
+	static uint32 NewSwingId()
+	{
+		static uint32 LastSwingId = 0;
+		if (++LastSwingId == 0)
+		{
+			++LastSwingId;
+		}
+		return LastSwingId;
+	}
+
+	bool HasHit(uint32 AttackerId, uint32 SwingId) const
+	{
+		for (const FSlot& Slot : Slots)
+		{
+			if (Slot.AttackerId == AttackerId)
+			{
+				return SwingId != 0 && Slot.SwingId == SwingId;
+			}
+		}
+		return false;
+	}
+
+	// Returns false if this swing has already hit the victim
+	bool TryRecordHit(uint32 AttackerId, uint32 SwingId)
+	{
+		for (FSlot& Slot : Slots)
+		{
+			if (Slot.AttackerId == AttackerId)
+			{
+				if (SwingId != 0 && Slot.SwingId == SwingId)
+				{
+					return false;
+				}
+				Slot.SwingId = SwingId;
+				return true;
+			}
+		}
+
+		Slots.Add({ AttackerId, SwingId });
+		return true;
+	}
+
+	void Reset()
+	{
+		Slots.Reset();
+	}
+
+private:
+	struct FSlot
+	{
+		uint32 AttackerId = 0;
+		uint32 SwingId = 0;
+	};
+
+	TArray<FSlot, TInlineAllocator<NumSlots>> Slots;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatResolutionSubsystem.generated.h"
+
+class AController;
+
+// A confirmed hit waiting to be resolved. Attackers have already de-duplicated it for the current swing.
+struct FCombatHitCandidate
+{
+	TWeakObjectPtr<AActor> Attacker;
+	TWeakObjectPtr<AActor> Victim;
+	TWeakObjectPtr<AActor> DamageCauser;		// weapon, or the attacker itself for kicks
+	FName Shape;								// hitbox shape that landed it; none for AWeapon's own traces
+	TWeakObjectPtr<AController> InstigatorController;
+	float Damage = 0.f;
+	FVector ImpactPoint = FVector::ZeroVector;
+	uint32 Sequence = 0;						// queue order, keeps sorting stable
+};
+
+/**
+ * Resolves combat hits once per frame instead of inside each overlap or trace callback.
+ * Weapons and kicks queue hits during the frame. After all actors have ticked, the queue is sorted by
+ * attacker and victim, and repeats from the same damage causer and shape are dropped, so a kick and a blade
+ * landing together both count. Damage and hit reactions are then applied in one pass, and each player's HUD
+ * gets a single targeted-enemy update, for the last hit queued.
+ * Eclipse.Combat.DeferHits 0 resolves every hit as it is queued (the old behaviour) for A/B runs.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UCombatResolutionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Queues on the world's subsystem, or resolves immediately when there is none (editor worlds) or deferral is off
+	static void QueueHit(const UObject* WorldContextObject, const FCombatHitCandidate& Hit);
+
+	//~ UTickableWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void Enqueue(const FCombatHitCandidate& Hit);
+	void ResolvePending();
+
+	// Damage, flight recorder, latency and hit reaction for one hit; returns the player that should target the victim
+	static APlayerController* ResolveHit(const FCombatHitCandidate& Hit);
+
+	TArray<FCombatHitCandidate> PendingHits;
+	TArray<FCombatHitCandidate> ResolvingHits;
+	uint32 NextSequence = 0;
+
+	struct FTargetUpdate
+	{
+		APlayerController* PlayerController = nullptr;
+		AActor* Victim = nullptr;
+		uint32 Sequence = 0;
+	};
+
+	// Scratch for the HUD pass, reused every frame
+	TArray<FTargetUpdate> TargetUpdates;
+};
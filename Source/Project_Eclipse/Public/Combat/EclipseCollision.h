@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+
+/*
+ * Combat collision setup. The channel and profiles are defined in DefaultEngine.ini:
+ *   Weapon         object channel (ECC_GameTraceChannel1), ignored by everything by default
+ *   WeaponHitbox   weapon boxes; Weapon object type, overlaps Pawn and nothing else
+ *   CombatHurtbox  character capsules; the Pawn profile plus an overlap with Weapon
+ * Character meshes have no collision: the capsule is the broad phase and UHurtboxComponent tests hit zones
+ * per bone for candidates that pass it. World geometry and other weapons ignore the Weapon channel, so the
+ * physics scene rejects those pairs before any overlap callback runs. The owner's own hierarchy is added to the hitbox's move-ignore
+ * list by AWeapon, which drops those pairs in the same query filter. UHitboxComponent queries the Weapon
+ * channel directly, so it sees the same hurtboxes without a collision component of its own.
+ * Eclipse.Collision.LegacyProfiles 1 restores the old per-component responses at BeginPlay for A/B runs.
+ */
+class PROJECT_ECLIPSE_API FEclipseCollision
+{
+public:
+	static constexpr ECollisionChannel WeaponChannel = ECC_GameTraceChannel1;
+	static const FName WeaponHitboxProfile;
+	static const FName CombatHurtboxProfile;
+
+	// Constructors
+	static void InitWeaponHitbox(UPrimitiveComponent* Component);
+	static void InitHurtbox(UPrimitiveComponent* Component);
+	static void InitCharacterMesh(UPrimitiveComponent* Component);
+
+	// BeginPlay; no-ops unless Eclipse.Collision.LegacyProfiles is set
+	static void ApplyLegacyHitbox(UPrimitiveComponent* Component);
+	static void ApplyLegacyCharacterMesh(UPrimitiveComponent* Component);
+	static bool UseLegacyProfiles();
+
+	// Weapon box overlap callbacks that reached combat code, for the benchmark
+	static void CountOverlapCallback();
+	static uint64 GetOverlapCallbackCount();
+};
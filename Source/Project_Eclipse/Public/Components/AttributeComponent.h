@@ -36,5 +36,8 @@ public:
 	float GetHealthPercent();
 	bool IsAlive();
 
+	// Back to full health, for characters reused from the actor pool
+	void ResetHealth();
+
 
 };
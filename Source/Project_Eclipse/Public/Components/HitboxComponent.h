@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Components/HurtboxComponent.h"
+#include "HitboxComponent.generated.h"
+
+class ABaseCharacter;
+
+// A capsule around a segment that follows a socket, e.g. a blade or a foot
+USTRUCT(BlueprintType)
+struct FHitboxShape
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FName Name;
+
+	// Socket or bone on the owner's mesh; none means the attach component's own transform
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FName Socket;
+
+	// Segment ends in socket space
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FVector LocalStart = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FVector LocalEnd = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox", meta = (ClampMin = "1"))
+	float Radius = 10.f;
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	float Damage = 10.f;
+
+	// UAttackTrajectoryAsset track followed instead of the socket when the owner's pose isn't evaluated
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FName TrajectoryTrack;
+
+	// Component the socket is looked up on; the owner's mesh when unset
+	UPROPERTY(Transient)
+	TObjectPtr<USceneComponent> AttachComponent = nullptr;
+
+	// Reported as the damage causer; the owner when unset
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	bool bActive = false;
+	FVector LastStart = FVector::ZeroVector;
+	FVector LastEnd = FVector::ZeroVector;
+	FVector CurrentStart = FVector::ZeroVector;
+	FVector CurrentEnd = FVector::ZeroVector;
+};
+
+/**
+ * Named attack shapes of one character: limbs, and the blade of the equipped weapon in Hitbox mode.
+ * While any shape is active the component ticks after physics and makes one overlap query per frame,
+ * covering the swept volume of every active shape. Each candidate capsule is then tested against each
+ * shape's sweep with a component-level query, and the victim's UHurtboxComponent narrows the hit down to a
+ * zone. Shapes share a single scene query and no collision components are toggled. Hits are de-duplicated against the owner's current swing and queued on
+ * UCombatResolutionSubsystem with the shape's damage.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class PROJECT_ECLIPSE_API UHitboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Adds the shape, or replaces the definition of the one with the same name
+	void AddOrUpdateShape(const FHitboxShape& Shape);
+	void SetShapeActive(FName ShapeName, bool bActive);
+	void DeactivateAllShapes();
+
+	// The weapon blade as the Blade shape on the baked blade track, segment in AttachComponent's space.
+	// Redefined on every activation so the weapon equipped now is the one that hits; used by AWeapon and UWeaponComponent.
+	void ActivateBlade(USceneComponent* AttachComponent, const FVector& LocalStart, const FVector& LocalEnd, float Radius, float Damage, AActor* DamageCauser);
+	void DeactivateBlade();
+	FORCEINLINE bool IsAnyShapeActive() const { return NumActiveShapes > 0; }
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	TArray<FHitboxShape> Shapes;
+
+private:
+	void EvaluateShapes();
+	void GetShapeSegment(const FHitboxShape& Shape, FVector& OutStart, FVector& OutEnd) const;
+	void RebuildIgnoreActors();
+
+	struct FHitboxHit
+	{
+		int32 ShapeIndex = INDEX_NONE;
+		TWeakObjectPtr<AActor> Victim;
+		FHitZoneResult Zone;
+	};
+
+	UPROPERTY()
+	ABaseCharacter* OwnerCharacter = nullptr;
+
+	UPROPERTY()
+	USceneComponent* DefaultAttachComponent = nullptr;
+
+	// The owner and everything attached to it, refreshed when the first shape activates
+	UPROPERTY()
+	TArray<AActor*> IgnoreActors;
+
+	int32 NumActiveShapes = 0;
+
+	// Scratch, reused every frame
+	TArray<FOverlapResult> Overlaps;
+	TArray<FHitboxHit> Hits;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HurtboxComponent.generated.h"
+
+class UPhysicsAsset;
+class USkeletalMeshComponent;
+
+UENUM(BlueprintType)
+enum class EHitZone : uint8
+{
+	Torso UMETA(DisplayName = "Torso"),
+	Head UMETA(DisplayName = "Head"),
+	Arm UMETA(DisplayName = "Arm"),
+	Leg UMETA(DisplayName = "Leg")
+};
+
+// Bodies of the hit zone asset on these bones take the zone's damage multiplier
+USTRUCT(BlueprintType)
+struct FHitZone
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Hit Zones")
+	EHitZone Zone = EHitZone::Torso;
+
+	UPROPERTY(EditAnywhere, Category = "Hit Zones")
+	TArray<FName> Bones;
+
+	UPROPERTY(EditAnywhere, Category = "Hit Zones", meta = (ClampMin = "0"))
+	float DamageMultiplier = 1.f;
+};
+
+struct FHitZoneResult
+{
+	EHitZone Zone = EHitZone::Torso;
+	FName Bone;
+	float DamageMultiplier = 1.f;
+	FVector ImpactPoint = FVector::ZeroVector;
+};
+
+/**
+ * Narrow phase for hits on a character. The capsule is the only collision weapons see, so idle characters
+ * cost no per-body physics. Once a hit query has passed the capsule, the attack segment is tested against
+ * the capsules of HitZoneAsset, a simplified physics asset whose shapes are read straight from the asset
+ * and posed with the mesh's current bone transforms. No physics bodies are created for it.
+ * Without an asset, or with Eclipse.Combat.HitZones 0, the capsule hit stands and counts as Torso.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class PROJECT_ECLIPSE_API UHurtboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHurtboxComponent();
+
+	FORCEINLINE bool HasHitZones() const { return Bodies.Num() > 0 && UseHitZones(); }
+
+	// Tests a capsule of the given radius swept from one pose of its segment to another against the hit zone bodies.
+	// False when it passes between them.
+	bool SweepHitZones(const FVector& PrevStart, const FVector& PrevEnd, const FVector& CurStart, const FVector& CurEnd, float Radius, FHitZoneResult& OutResult) const;
+
+	// Zone of the body nearest to a point, for hits confirmed against the capsule a frame late (async traces)
+	void FindNearestZone(const FVector& Point, FHitZoneResult& OutResult) const;
+
+	static bool UseHitZones();
+
+	// Narrow phase for an attack that has passed Victim's capsule. Victims without hit zones take the capsule
+	// hit as Torso at FallbackImpact; otherwise false when the attack misses every body.
+	static bool ConfirmHit(AActor* Victim, const FVector& PrevStart, const FVector& PrevEnd, const FVector& CurStart, const FVector& CurEnd,
+		float Radius, const FVector& FallbackImpact, FHitZoneResult& OutResult);
+
+	// Zone of a capsule hit that can no longer be tested against the attack (async traces)
+	static void ClassifyHit(AActor* Victim, const FVector& ImpactPoint, FHitZoneResult& OutResult);
+
+protected:
+	virtual void BeginPlay() override;
+
+	// Simplified physics asset for the owner's skeleton; a handful of capsules is enough
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Zones")
+	UPhysicsAsset* HitZoneAsset = nullptr;
+
+	// Bodies on bones not listed here are Torso with a multiplier of 1
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Zones")
+	TArray<FHitZone> HitZones;
+
+private:
+	// A body of the hit zone asset reduced to a capsule in bone space
+	struct FZoneBody
+	{
+		int32 BoneIndex = INDEX_NONE;
+		int32 ZoneIndex = INDEX_NONE;
+		FVector LocalStart = FVector::ZeroVector;
+		FVector LocalEnd = FVector::ZeroVector;
+		float Radius = 0.f;
+	};
+
+	struct FPosedBody
+	{
+		FVector Start;
+		FVector End;
+		float Radius;
+	};
+
+	void CacheBodies();
+	void AddBody(int32 BoneIndex, int32 ZoneIndex, const FVector& LocalStart, const FVector& LocalEnd, float Radius);
+	void PoseBodies(TArray<FPosedBody, TInlineAllocator<16>>& OutPosed) const;
+	void FillResult(int32 BodyIndex, const FVector& ImpactPoint, FHitZoneResult& OutResult) const;
+
+	UPROPERTY()
+	USkeletalMeshComponent* Mesh = nullptr;
+
+	TArray<FZoneBody> Bodies;
+	float MinBodyRadius = 0.f;
+};
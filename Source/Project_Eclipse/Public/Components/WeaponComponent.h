@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StaticMeshComponent.h"
+#include "WeaponComponent.generated.h"
+
+class AWeapon;
+
+/**
+ * A character's weapon as a mesh component on its hand socket instead of a separate AWeapon actor.
+ * Equip copies the mesh, blade segment, damage and thickness from an AWeapon class's defaults. Hit windows
+ * add that blade to the owner's UHitboxComponent exactly like AWeapon's Hitbox mode, so there is no weapon
+ * actor, tick, collision box or attachment to keep in the owner's ignore lists. Overlap and Continuous
+ * hit modes need the weapon actor and aren't available here. AWeapon stays for the player and for pickups.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class PROJECT_ECLIPSE_API UWeaponComponent : public UStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponComponent();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Shows the class's mesh and takes its blade; false (and nothing equipped) when the class has no sword mesh
+	bool Equip(TSubclassOf<AWeapon> InWeaponClass);
+
+	// Closes any open window and hides the mesh
+	void Unequip();
+
+	// Activates or deactivates the blade on the owner's hitbox component; open windows are counted like AWeapon's
+	void SetCollisionWindowEnabled(bool bOpen);
+
+	FORCEINLINE bool IsEquipped() const { return WeaponClass != nullptr; }
+	FORCEINLINE bool IsCollisionWindowOpen() const { return bCollisionWindowOpen; }
+	FORCEINLINE TSubclassOf<AWeapon> GetWeaponClass() const { return WeaponClass; }
+
+private:
+	UPROPERTY(VisibleInstanceOnly, Category = "Weapon")
+	TSubclassOf<AWeapon> WeaponClass;
+
+	// Blade in this component's space, from the weapon's BoxTraceStart/BoxTraceEnd
+	FVector BladeStart = FVector::ZeroVector;
+	FVector BladeEnd = FVector::ZeroVector;
+	float BladeRadius = 5.f;
+	float Damage = 0.f;
+
+	bool bCollisionWindowOpen = false;
+};
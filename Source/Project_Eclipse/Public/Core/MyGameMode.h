@@ -4,6 +4,43 @@
 #include "GameFramework/GameModeBase.h"
 #include "MyGameMode.generated.h"
 
+class AEnemy;
+
+USTRUCT(BlueprintType)
+struct FEnemySpawnRequest
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    TSubclassOf<AEnemy> EnemyClass;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    FTransform Transform;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    TArray<AActor*> PatrolTargets;
+
+    // First patrol target; none leaves the enemy's own
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    AActor* PatrolTarget = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    bool bEnableCombatAI = true;
+
+    // Caller's id for the request, passed back to OnEnemySpawned or OnEnemySpawnFailed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Encounter")
+    int32 Tag = INDEX_NONE;
+};
+
+/**
+ * Owns the encounter director: enemy spawn requests are queued and worked off in Tick within
+ * SpawnBudgetMs per frame (Eclipse.Spawn.BudgetMs overrides it), so a wave arrives over a few frames
+ * instead of in one long one. Each enemy is spawned in two steps on different frames, through the actor
+ * pool when it has one: the deferred spawn (constructor and components, or a parked enemy) and, on a later
+ * frame, the finish (BeginPlay or the pool reset, controller, weapon). A step starts only while its running
+ * average fits the frame's remaining budget; the first step of a frame always runs so the queue drains.
+ * Queuing a request starts loading the class's UCombatAssetSet, and requests wait in line until it has loaded.
+ */
 UCLASS()
 class PROJECT_ECLIPSE_API AMyGameMode : public AGameModeBase
 {
@@ -11,4 +48,51 @@ class PROJECT_ECLIPSE_API AMyGameMode : public AGameModeBase
 
 public:
     AMyGameMode();
-}; 
\ No newline at end of file
+
+    virtual void Tick(float DeltaSeconds) override;
+
+    UFUNCTION(BlueprintCallable, Category = "Encounter")
+    void QueueEnemySpawn(const FEnemySpawnRequest& Request);
+
+    UFUNCTION(BlueprintCallable, Category = "Encounter")
+    void QueueWave(const TArray<FEnemySpawnRequest>& Wave);
+
+    // Requests not yet finished, including enemies spawned but not yet begun
+    UFUNCTION(BlueprintPure, Category = "Encounter")
+    int32 GetNumPendingSpawns() const;
+
+protected:
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Called once the enemy of a request has begun play
+    virtual void OnEnemySpawned(AEnemy* Enemy, int32 Tag) {}
+
+    // Called instead when the enemy couldn't be spawned or was destroyed before its finish step
+    virtual void OnEnemySpawnFailed(int32 Tag) {}
+
+    UPROPERTY(EditDefaultsOnly, Category = "Encounter", meta = (ClampMin = "0.1"))
+    float SpawnBudgetMs = 2.f;
+
+private:
+    // A request whose enemy has been spawned deferred and waits for its finish step
+    struct FDeferredEnemy
+    {
+        TWeakObjectPtr<AEnemy> Enemy;
+        FTransform Transform;
+        int32 Tag = INDEX_NONE;
+    };
+
+    void ProcessSpawnQueue();
+    bool SpawnDeferred(const FEnemySpawnRequest& Request);
+    void FinishSpawn(const FDeferredEnemy& Deferred);
+
+    UPROPERTY()
+    TArray<FEnemySpawnRequest> SpawnQueue;
+    int32 SpawnQueueHead = 0;
+
+    TArray<FDeferredEnemy> DeferredEnemies;
+
+    // Running averages of each step, in milliseconds
+    double AverageSpawnMs = 0.5;
+    double AverageFinishMs = 0.5;
+};
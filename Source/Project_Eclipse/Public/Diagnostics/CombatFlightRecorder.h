@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+#ifndef WITH_ECLIPSE_FLIGHT_RECORDER
+#define WITH_ECLIPSE_FLIGHT_RECORDER 1
+#endif
+
+class FRunnableThread;
+class IFileHandle;
+
+enum class ECombatEventType : uint8
+{
+	WeaponOverlap,
+	BoxTrace,
+	ApplyDamage,
+	GetHit,
+	Die,
+	EnemyStateChange,
+	ActionStateChange,
+
+	Count
+};
+
+/**
+ * One combat event. Fixed size POD; this is also the on-disk record layout.
+ * Actors are identified by UObject unique id, which is stable for the lifetime of the actor.
+ */
+struct FCombatEventRecord
+{
+	uint64 Cycles = 0;				// FPlatformTime::Cycles64()
+	uint32 Frame = 0;				// GFrameCounter (low 32 bits)
+	uint32 SourceId = 0;			// attacker, or the actor whose state changed
+	uint32 TargetId = 0;			// victim / hit actor
+	float Value = 0.f;				// damage, or 1/0 for a trace hit/miss
+	FVector3f Location = FVector3f::ZeroVector;
+	ECombatEventType Type = ECombatEventType::WeaponOverlap;
+	uint8 OldState = 0;
+	uint8 NewState = 0;
+	uint8 Padding = 0;
+};
+static_assert(sizeof(FCombatEventRecord) == 40, "FCombatEventRecord is an on-disk format");
+
+// Header at the start of every flight record file
+struct FCombatFlightRecordHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x52464345; // 'ECFR'
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 RecordSize = sizeof(FCombatEventRecord);
+	uint32 Padding = 0;
+	double SecondsPerCycle = 0.0;
+	uint64 StartCycles = 0;
+};
+static_assert(sizeof(FCombatFlightRecordHeader) == 32, "FCombatFlightRecordHeader is an on-disk format");
+
+/**
+ * Always-on combat flight recorder.
+ * Game code pushes records into a per-thread single-producer ring (no locks, no allocation after the
+ * first record on a thread). A thread that exits hands its ring back for the next new thread to reuse, so
+ * short-lived threads don't add a ring each. A background thread drains the rings a few times per second and appends
+ * them to Saved/FlightRecorder/Combat_<pid>.ecfr. Once a file spans Eclipse.FlightRecorder.WindowSeconds
+ * it is rotated to Combat_<pid>.prev.ecfr, so the last N seconds are always on disk.
+ * Decode with: -run=DecodeCombatFlightRecord -File=<path>
+ */
+class PROJECT_ECLIPSE_API FCombatFlightRecorder : public FRunnable
+{
+public:
+	static FCombatFlightRecorder& Get();
+
+	static bool IsEnabled();
+
+	static void Record(ECombatEventType Type, const UObject* Source, const UObject* Target,
+		float Value = 0.f, const FVector& Location = FVector::ZeroVector, uint8 OldState = 0, uint8 NewState = 0);
+
+	// Stops the writer thread after a final flush (module shutdown)
+	void Shutdown();
+
+	//~ FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	static constexpr uint32 RingCapacity = 4096;
+
+	struct FThreadRing
+	{
+		FCombatEventRecord Records[RingCapacity];
+		std::atomic<uint64> Head{0};
+		std::atomic<uint64> Tail{0};
+		std::atomic<uint32> Dropped{0};
+
+		// Cleared by the owning thread's lease when the thread exits
+		std::atomic<bool> bInUse{true};
+
+		void Push(const FCombatEventRecord& InRecord);
+		void Drain(TArray<FCombatEventRecord>& Out);
+	};
+
+	FCombatFlightRecorder() = default;
+	~FCombatFlightRecorder();
+
+	// Held in a thread_local; gives the ring back when the thread exits
+	struct FThreadRingLease
+	{
+		FThreadRing* Ring = nullptr;
+		~FThreadRingLease();
+	};
+
+	FThreadRing* RegisterCurrentThread();
+	void Flush();
+	bool OpenFile();
+	void CloseFile();
+	void RotateFile();
+
+	FCriticalSection RingsLock;
+	TArray<TUniquePtr<FThreadRing>> Rings;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopping{false};
+	bool bShutDown = false;
+
+	// Writer thread state
+	IFileHandle* File = nullptr;
+	FString FilePath;
+	FString PreviousFilePath;
+	uint64 FileStartCycles = 0;
+	TArray<FCombatEventRecord> DrainBuffer;
+};
+
+#if WITH_ECLIPSE_FLIGHT_RECORDER
+#define ECLIPSE_RECORD_COMBAT_EVENT(...) FCombatFlightRecorder::Record(__VA_ARGS__)
+#else
+#define ECLIPSE_RECORD_COMBAT_EVENT(...) do {} while (0)
+#endif
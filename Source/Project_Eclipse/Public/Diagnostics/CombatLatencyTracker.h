@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef ECLIPSE_WITH_LATENCY_TRACKING
+#define ECLIPSE_WITH_LATENCY_TRACKING !UE_BUILD_SHIPPING
+#endif
+
+// Points along a melee attack, in the order they normally happen
+enum class ECombatLatencyStage : uint8
+{
+	Input,			// attack input handled, before it is accepted (AMyCharacter::Attack1/2/3)
+	MontageStart,	// Montage_Play returned in PlayAttackMontageSection
+	WeaponWindow,	// UANS_EnableWeaponCollision::NotifyBegin
+	KickWindow,		// kick shapes activated (after the EnableKickCollision timer)
+	FirstContact,	// first weapon overlap or hitbox contact while attacking
+	Damage,			// ApplyDamage called
+	HealthBar,		// victim health bar updated
+
+	Count
+};
+
+/**
+ * Input-to-impact latency per attack section.
+ * Each attacker has at most one attack in flight; every stage records the time since Input the first
+ * time it is reached. Completed attacks go into per-section, per-stage histograms.
+ *   Eclipse.Latency.Report  logs count / mean / p50 / p95 / max (ms and frames) per section and stage
+ *   Eclipse.Latency.Reset   clears the histograms
+ * The combat benchmark resets after warmup and appends the report to Saved/Benchmarks/CombatLatency.csv.
+ * Game thread only.
+ */
+class PROJECT_ECLIPSE_API FCombatLatencyTracker
+{
+public:
+	static FCombatLatencyTracker& Get();
+
+	// Stamps Input for the attacker's next BeginAttack; call CancelInput when the attack is rejected
+	void MarkInput(const AActor* Attacker);
+	void CancelInput(const AActor* Attacker);
+
+	// Starts the attack's timeline from the pending input, or from now when there is none
+	void BeginAttack(const AActor* Attacker, FName Section);
+	void Mark(const AActor* Attacker, ECombatLatencyStage Stage);
+	void EndAttack(const AActor* Attacker);
+
+	void Reset();
+	void LogReport() const;
+	bool AppendCsv(const FString& FilePath, const FString& RunLabel) const;
+
+	static const TCHAR* GetStageName(ECombatLatencyStage Stage);
+
+private:
+	struct FHistogram
+	{
+		static constexpr double BucketMs = 2.0;
+		static constexpr int32 NumBuckets = 128;	// last bucket collects everything above 254 ms
+
+		uint32 Buckets[NumBuckets] = {};
+		uint32 Count = 0;
+		double SumMs = 0.0;
+		double MaxMs = 0.0;
+		uint64 SumFrames = 0;
+
+		void Add(double Ms, uint32 Frames);
+		double Percentile(double Percent) const;
+	};
+
+	struct FSectionStats
+	{
+		FHistogram Stages[static_cast<int32>(ECombatLatencyStage::Count)];
+	};
+
+	struct FAttackTimeline
+	{
+		FName Section;
+		double Seconds[static_cast<int32>(ECombatLatencyStage::Count)] = {};
+		uint64 Frames[static_cast<int32>(ECombatLatencyStage::Count)] = {};
+		uint32 ReachedMask = 0;
+	};
+
+	struct FInputStamp
+	{
+		double Seconds = 0.0;
+		uint64 Frame = 0;
+	};
+
+	void Complete(const FAttackTimeline& Timeline);
+
+	// Kept apart from InFlight so a rejected input doesn't close the attack already in flight
+	TMap<uint32, FInputStamp> PendingInputs;
+	TMap<uint32, FAttackTimeline> InFlight;
+	TMap<FName, FSectionStats> Sections;
+};
+
+#if ECLIPSE_WITH_LATENCY_TRACKING
+#define ECLIPSE_LATENCY_INPUT(Attacker) FCombatLatencyTracker::Get().MarkInput(Attacker)
+#define ECLIPSE_LATENCY_CANCEL_INPUT(Attacker) FCombatLatencyTracker::Get().CancelInput(Attacker)
+#define ECLIPSE_LATENCY_BEGIN_ATTACK(Attacker, Section) FCombatLatencyTracker::Get().BeginAttack(Attacker, Section)
+#define ECLIPSE_LATENCY_MARK(Attacker, Stage) FCombatLatencyTracker::Get().Mark(Attacker, ECombatLatencyStage::Stage)
+#define ECLIPSE_LATENCY_END_ATTACK(Attacker) FCombatLatencyTracker::Get().EndAttack(Attacker)
+#else
+#define ECLIPSE_LATENCY_INPUT(Attacker) do {} while (0)
+#define ECLIPSE_LATENCY_CANCEL_INPUT(Attacker) do {} while (0)
+#define ECLIPSE_LATENCY_BEGIN_ATTACK(Attacker, Section) do {} while (0)
+#define ECLIPSE_LATENCY_MARK(Attacker, Stage) do {} while (0)
+#define ECLIPSE_LATENCY_END_ATTACK(Attacker) do {} while (0)
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DecodeCombatFlightRecordCommandlet.generated.h"
+
+/**
+ * Converts a combat flight record (.ecfr) to CSV.
+ *   UnrealEditor-Cmd Project_Eclipse.uproject -run=DecodeCombatFlightRecord -File=Saved/FlightRecorder/Combat_1234.ecfr [-Out=Path.csv]
+ * Without -Out the CSV is written next to the input file.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UDecodeCombatFlightRecordCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDecodeCombatFlightRecordCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
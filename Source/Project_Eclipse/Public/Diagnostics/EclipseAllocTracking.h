@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Diagnostics/EclipseStats.h"
+#include <atomic>
+
+#ifndef ECLIPSE_WITH_ALLOC_TRACKING
+#define ECLIPSE_WITH_ALLOC_TRACKING !UE_BUILD_SHIPPING
+#endif
+
+/*
+ * Heap allocation counting for combat hot paths.
+ * With -EclipseAllocTracking a counting proxy is put in front of GMalloc at module startup, and every
+ * ECLIPSE_ALLOC_SCOPE(Name) adds the allocations made inside it (including nested calls) to the
+ * STAT_EclipseAllocs_<Name> counter ("stat Eclipse"). The combat benchmark opens a window after warmup
+ * and fails the run if any scope allocated during it. Scopes are a no-op when the proxy is not installed.
+ */
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocs ChoosePatrolTarget"), STAT_EclipseAllocs_EnemyChoosePatrolTarget, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocs Weapon BoxTrace"), STAT_EclipseAllocs_WeaponBoxTrace, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocs Weapon Overlap Query"), STAT_EclipseAllocs_WeaponOverlapQuery, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocs Weapon SweepBlade"), STAT_EclipseAllocs_WeaponSweepBlade, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocs Hitbox Query"), STAT_EclipseAllocs_HitboxQuery, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+#if ECLIPSE_WITH_ALLOC_TRACKING
+
+struct PROJECT_ECLIPSE_API FEclipseAllocScopeCounter
+{
+	explicit FEclipseAllocScopeCounter(const TCHAR* InName);
+
+	const TCHAR* Name;
+	std::atomic<uint64> Allocations{0};
+	std::atomic<uint64> Calls{0};
+};
+
+class PROJECT_ECLIPSE_API FEclipseAllocTracking
+{
+public:
+	// Wraps GMalloc; cannot be undone
+	static void Install();
+	static bool IsInstalled() { return bInstalled; }
+
+	// Allocations made by the calling thread since it started
+	static uint64 GetThreadAllocationCount();
+
+	// Discards counts taken so far, e.g. at the end of a warmup
+	static void BeginWindow();
+
+	// Logs every scope that allocated in the window; returns how many did
+	static int32 CheckNoAllocations();
+
+private:
+	friend struct FEclipseAllocScopeCounter;
+	static void Register(FEclipseAllocScopeCounter& Counter);
+
+	static bool bInstalled;
+};
+
+class FEclipseAllocScope
+{
+public:
+	FEclipseAllocScope(FEclipseAllocScopeCounter& InCounter, TStatId InStatId)
+		: Counter(InCounter)
+		, StatId(InStatId)
+		, bActive(FEclipseAllocTracking::IsInstalled())
+		, StartCount(bActive ? FEclipseAllocTracking::GetThreadAllocationCount() : 0)
+	{
+	}
+
+	~FEclipseAllocScope()
+	{
+		Stop();
+	}
+
+	// Ends the scope early, e.g. before handing off to engine code whose allocations should not count
+	void Stop()
+	{
+		if (!bActive)
+		{
+			return;
+		}
+		bActive = false;
+
+		const uint64 Allocations = FEclipseAllocTracking::GetThreadAllocationCount() - StartCount;
+		Counter.Calls.fetch_add(1, std::memory_order_relaxed);
+		if (Allocations > 0)
+		{
+			Counter.Allocations.fetch_add(Allocations, std::memory_order_relaxed);
+#if STATS
+			INC_DWORD_STAT_BY_FName(StatId.GetName(), Allocations);
+#endif
+		}
+	}
+
+private:
+	FEclipseAllocScopeCounter& Counter;
+	TStatId StatId;
+	bool bActive;
+	uint64 StartCount;
+};
+
+#define ECLIPSE_ALLOC_SCOPE(Name) \
+	static FEclipseAllocScopeCounter PREPROCESSOR_JOIN(EclipseAllocCounter_, Name)(TEXT(#Name)); \
+	FEclipseAllocScope PREPROCESSOR_JOIN(EclipseAllocScope_, Name)(PREPROCESSOR_JOIN(EclipseAllocCounter_, Name), GET_STATID(STAT_EclipseAllocs_##Name))
+
+#define ECLIPSE_ALLOC_SCOPE_END(Name) PREPROCESSOR_JOIN(EclipseAllocScope_, Name).Stop()
+
+#else
+
+#define ECLIPSE_ALLOC_SCOPE(Name)
+#define ECLIPSE_ALLOC_SCOPE_END(Name)
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+// Shared with Tools/EclipseCounterReader, so this header uses no engine types or includes
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Fixed layout of the live counter block the game publishes once per frame to the named shared memory
+ * region "EclipseLiveCounters_<pid>" (POSIX: shm "/EclipseLiveCounters_<pid>").
+ *
+ * Sequence is a seqlock: the game makes it odd while writing and even when done. A reader copies the
+ * block, and keeps the copy only if Sequence was even and unchanged across the copy.
+ * Only append fields; bump Version when the meaning of an existing field changes.
+ */
+struct FEclipseLiveCounterBlock
+{
+	static constexpr uint32_t ExpectedMagic = 0x434C4345; // 'ECLC'
+	static constexpr uint32_t CurrentVersion = 1;
+
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t Size;						// sizeof(FEclipseLiveCounterBlock) of the writer
+	uint32_t ProcessId;
+
+	std::atomic<uint32_t> Sequence;
+	uint32_t Padding0;
+
+	uint64_t Frame;						// GFrameCounter of the frame that was published
+	double FrameTimeMs;					// delta time of that frame
+	double GameThreadMs;				// game thread time of the previous frame (GGameThreadTime)
+	double DamageEventsPerSecond;		// averaged over the last second
+
+	uint32_t LiveEnemies;				// enemies that have begun play and not died
+	uint32_t ActiveWeaponWindows;		// weapons with their collision box enabled
+	uint32_t TracesPerFrame;
+	uint32_t OverlapsPerFrame;
+	uint32_t DamageEventsPerFrame;
+	uint32_t PooledInUse;				// pooled combat objects currently handed out
+	uint32_t PooledCapacity;			// pooled combat objects allocated
+	uint32_t Padding1;
+};
+static_assert(sizeof(FEclipseLiveCounterBlock) == 88, "FEclipseLiveCounterBlock is shared with external readers");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Sequence must be lock free to live in shared memory");
+
+#define ECLIPSE_LIVE_COUNTERS_REGION_PREFIX "EclipseLiveCounters_"
+
+// Copies a consistent snapshot of Source into Out; false if every attempt overlapped a write
+inline bool TryReadEclipseLiveCounters(const FEclipseLiveCounterBlock& Source, FEclipseLiveCounterBlock& Out, int MaxAttempts = 64)
+{
+	for (int Attempt = 0; Attempt < MaxAttempts; ++Attempt)
+	{
+		const uint32_t Before = Source.Sequence.load(std::memory_order_acquire);
+		if (Before & 1u)
+		{
+			continue;
+		}
+
+		std::memcpy(static_cast<void*>(&Out), static_cast<const void*>(&Source), sizeof(Out));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Source.Sequence.load(std::memory_order_relaxed) == Before)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Diagnostics/EclipseLiveCounterLayout.h"
+
+/*
+ * Live performance counters for external monitoring.
+ * With -EclipseLiveCounters the game maps the shared memory block described in EclipseLiveCounterLayout.h
+ * and publishes it at the end of every frame (a few stores, no locks, no allocation). A sidecar such as
+ * Tools/EclipseCounterReader reads it without touching the game thread.
+ * The Add/Count calls are always live so the block is correct whenever publishing starts.
+ */
+class PROJECT_ECLIPSE_API FEclipseLiveCounters
+{
+public:
+	static bool Start();
+	static void Stop();
+	static bool IsRunning();
+
+	// Level counters
+	static void AddLiveEnemies(int32 Delta);
+	static void AddActiveWeaponWindows(int32 Delta);
+	static void SetPoolOccupancy(uint32 InUse, uint32 Capacity);
+
+	// Per-frame counters
+	static void CountTrace();
+	static void CountOverlap();
+	static void CountDamageEvent();
+
+	static FString GetRegionName(uint32 ProcessId);
+
+	// Opens the region of the given process read-only, the same way an external reader would
+	static bool ReadSnapshot(uint32 ProcessId, FEclipseLiveCounterBlock& OutBlock);
+
+private:
+	static void Publish();
+};
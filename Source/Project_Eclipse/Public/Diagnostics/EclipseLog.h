@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+#include "Engine/Engine.h"
+
+/*
+ * Logging for the combat code.
+ * ECLIPSE_LOG and ECLIPSE_SCREEN_MESSAGE compile out completely in Test and Shipping builds, so their
+ * arguments (including any FString::Printf) are never evaluated there. In other builds ECLIPSE_LOG is
+ * filtered by the category verbosity ("log LogEclipseCombat Verbose") and ECLIPSE_SCREEN_MESSAGE by
+ * Eclipse.Debug.ScreenMessages, both before any formatting happens.
+ */
+
+#ifndef ECLIPSE_WITH_DEBUG_LOGGING
+#define ECLIPSE_WITH_DEBUG_LOGGING !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+// General project messages that should survive into Test builds (benchmark results, tooling)
+PROJECT_ECLIPSE_API DECLARE_LOG_CATEGORY_EXTERN(LogEclipse, Log, All);
+
+PROJECT_ECLIPSE_API DECLARE_LOG_CATEGORY_EXTERN(LogEclipseCombat, Log, All);
+PROJECT_ECLIPSE_API DECLARE_LOG_CATEGORY_EXTERN(LogEclipseAI, Log, All);
+PROJECT_ECLIPSE_API DECLARE_LOG_CATEGORY_EXTERN(LogEclipseHUD, Log, All);
+
+#if ECLIPSE_WITH_DEBUG_LOGGING
+
+// Eclipse.Debug.ScreenMessages
+extern PROJECT_ECLIPSE_API int32 GEclipseScreenMessages;
+
+#define ECLIPSE_LOG(Category, Verbosity, Format, ...) \
+	UE_LOG(Category, Verbosity, Format, ##__VA_ARGS__)
+
+#define ECLIPSE_SCREEN_MESSAGE(Duration, Color, Message) \
+	do \
+	{ \
+		if (GEclipseScreenMessages != 0 && GEngine) \
+		{ \
+			GEngine->AddOnScreenDebugMessage(-1, Duration, Color, Message); \
+		} \
+	} while (0)
+
+#else
+
+#define ECLIPSE_LOG(Category, Verbosity, Format, ...) do {} while (0)
+#define ECLIPSE_SCREEN_MESSAGE(Duration, Color, Message) do {} while (0)
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/*
+ * Low-level memory tracker tags. Run with -llm (or -llmcsv) and use "stat LLMFULL" / the LLM CSV:
+ *   Eclipse/Enemies  enemy actors and their components (mesh, movement, attributes)
+ *   Eclipse/Weapons  weapon actors and their components
+ *   Eclipse/HUD      overlay widgets, player health bar, enemy health bar widget components
+ *   Eclipse/AI       AI controllers, path following and perception
+ *   Eclipse/Combat   hit lists, flight recorder buffers and replay input
+ * Everything compiles out when LLM is disabled (Shipping by default).
+ */
+
+LLM_DECLARE_TAG_API(Eclipse, PROJECT_ECLIPSE_API);
+LLM_DECLARE_TAG_API(Eclipse_Enemies, PROJECT_ECLIPSE_API);
+LLM_DECLARE_TAG_API(Eclipse_Weapons, PROJECT_ECLIPSE_API);
+LLM_DECLARE_TAG_API(Eclipse_HUD, PROJECT_ECLIPSE_API);
+LLM_DECLARE_TAG_API(Eclipse_AI, PROJECT_ECLIPSE_API);
+LLM_DECLARE_TAG_API(Eclipse_Combat, PROJECT_ECLIPSE_API);
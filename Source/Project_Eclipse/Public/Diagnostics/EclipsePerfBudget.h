@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+#ifndef ECLIPSE_WITH_PERF_BUDGETS
+#define ECLIPSE_WITH_PERF_BUDGETS !UE_BUILD_SHIPPING
+#endif
+
+/*
+ * Performance budgets.
+ * ECLIPSE_PERF_BUDGET(Name, Microseconds) times the enclosing scope against a budget. The default in code
+ * can be overridden per name in Config/EclipsePerfBudgets.json. Timing is off unless budgets are enabled
+ * (-EclipsePerfBudgets or Eclipse.PerfBudgets.Enable 1); the combat benchmark opens a sample window after
+ * its warmup and fails the run if any budget's mean over that window is exceeded.
+ */
+
+#if ECLIPSE_WITH_PERF_BUDGETS
+
+struct PROJECT_ECLIPSE_API FEclipsePerfBudget
+{
+	FEclipsePerfBudget(const TCHAR* InName, double InDefaultMicroseconds);
+
+	void AddSample(uint64 Cycles)
+	{
+		TotalCycles.fetch_add(Cycles, std::memory_order_relaxed);
+		Samples.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const TCHAR* Name;
+	double BudgetMicroseconds;
+	std::atomic<uint64> TotalCycles{0};
+	std::atomic<uint64> Samples{0};
+};
+
+class PROJECT_ECLIPSE_API FEclipsePerfBudgets
+{
+public:
+	static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(bool bInEnabled);
+
+	// Discards samples taken so far, e.g. at the end of a warmup
+	static void BeginWindow();
+
+	// Logs every budget with samples in the window; returns the number of budgets exceeded
+	static int32 CheckBudgets(int32 MinSamples = 30);
+
+private:
+	friend struct FEclipsePerfBudget;
+	static void Register(FEclipsePerfBudget& Budget);
+
+	static bool bEnabled;
+};
+
+class FEclipsePerfBudgetScope
+{
+public:
+	explicit FEclipsePerfBudgetScope(FEclipsePerfBudget& InBudget)
+		: Budget(InBudget)
+		, StartCycles(FEclipsePerfBudgets::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FEclipsePerfBudgetScope()
+	{
+		if (StartCycles != 0)
+		{
+			Budget.AddSample(FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	FEclipsePerfBudget& Budget;
+	uint64 StartCycles;
+};
+
+#define ECLIPSE_PERF_BUDGET(Name, Microseconds) \
+	static FEclipsePerfBudget PREPROCESSOR_JOIN(EclipsePerfBudget_, Name)(TEXT(#Name), Microseconds); \
+	FEclipsePerfBudgetScope PREPROCESSOR_JOIN(EclipsePerfBudgetScope_, Name)(PREPROCESSOR_JOIN(EclipsePerfBudget_, Name))
+
+#else
+
+#define ECLIPSE_PERF_BUDGET(Name, Microseconds)
+
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/*
+ * Combat profiling.
+ * "stat Eclipse" shows the cycle counters and per-frame counters below.
+ * "-trace=default,Eclipse" (or "trace.enable Eclipse") adds the same scopes to Unreal Insights.
+ * Both compile to a disabled-check when off and to nothing when STATS / UE_TRACE_ENABLED are 0.
+ */
+
+DECLARE_STATS_GROUP(TEXT("Eclipse"), STATGROUP_Eclipse, STATCAT_Advanced);
+
+// Weapon
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon OnBoxOverlap"), STAT_EclipseWeaponOnBoxOverlap, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon BoxTrace"), STAT_EclipseWeaponBoxTrace, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon SweepBlade"), STAT_EclipseWeaponSweepBlade, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon AsyncTraceDone"), STAT_EclipseWeaponAsyncTraceDone, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon GatherAttachedActors"), STAT_EclipseWeaponGatherAttached, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Combat resolution
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat ResolveHits"), STAT_EclipseCombatResolve, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Actor pool
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Acquire"), STAT_EclipsePoolAcquire, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pool Release"), STAT_EclipsePoolRelease, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Encounter director
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Director SpawnQueue"), STAT_EclipseSpawnDirector, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Combat assets
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Assets Prewarm"), STAT_EclipseAssetPrewarm, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Hit effects
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat HitEffects"), STAT_EclipseHitEffects, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Characters
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Character DirectionalHitReact"), STAT_EclipseDirectionalHitReact, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hitbox Query"), STAT_EclipseHitboxQuery, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hurtbox Narrowphase"), STAT_EclipseHurtboxNarrowphase, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Enemy AI and animation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy Tick"), STAT_EclipseEnemyTick, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy MoveToTarget"), STAT_EclipseEnemyMoveToTarget, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy InTargetRange"), STAT_EclipseEnemyInTargetRange, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EnemyAnim NativeUpdateAnimation"), STAT_EclipseEnemyAnimUpdate, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// HUD
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD SetTargetedEnemy"), STAT_EclipseHUDSetTargetedEnemy, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD ClearTargetedEnemy"), STAT_EclipseHUDClearTargetedEnemy, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_EclipseTraces, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overlaps"), STAT_EclipseOverlaps, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Applications"), STAT_EclipseDamageApplications, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Montage Plays"), STAT_EclipseMontagePlays, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Spawns"), STAT_EclipsePoolSpawns, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Director Spawns"), STAT_EclipseDirectorSpawns, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effects Spawned"), STAT_EclipseEffectsSpawned, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effects Merged"), STAT_EclipseEffectsMerged, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effects Culled"), STAT_EclipseEffectsCulled, STATGROUP_Eclipse, PROJECT_ECLIPSE_API);
+
+UE_TRACE_CHANNEL_EXTERN(EclipseChannel, PROJECT_ECLIPSE_API);
+
+// Scopes the enclosing block for both "stat Eclipse" and the Eclipse Insights channel
+#define ECLIPSE_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, EclipseChannel)
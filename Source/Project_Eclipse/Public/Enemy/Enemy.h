@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Interfaces/HitInterface.h"
+#include "Interfaces/PooledActor.h"
 #include "Characters/BaseCharacter.h"
 #include "Characters/CharacterTypes.h"
 #include "Enemy.generated.h"
@@ -15,7 +16,7 @@ class UAIPerceptionComponent;
 class AWeapon;
 
 UCLASS()
-class PROJECT_ECLIPSE_API AEnemy : public ABaseCharacter
+class PROJECT_ECLIPSE_API AEnemy : public ABaseCharacter, public IPooledActor
 {
 	GENERATED_BODY()
 
@@ -39,13 +40,25 @@ public:
 
 	// Add ActionState variable
 	EActionState ActionState = EActionState::EAS_Unoccupied;
+	virtual bool IsAttacking() const override { return ActionState == EActionState::EAS_Attacking; }
+
+	// State changes go through these so they show up in the combat flight recorder
+	void SetEnemyState(EEnemyState NewState);
+	void SetActionState(EActionState NewState);
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components")
 	UHealthBarComponent* HealthBarWidget1;
 
+#if WITH_EDITOR
+	// Also checks DeathMontage against CombatAssets
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void SpawnDefaultController() override;
 
 
 	void Die();
@@ -61,6 +74,9 @@ protected:
 
 	virtual void PlayHitReactMontage(const FName& SectionName) override;
 
+	// Also takes the death montage, and equips the weapon when the set arrives after the enemy started
+	virtual void ApplyCombatAssets() override;
+
 	// Add AttackEnd function declaration
 	virtual void AttackEnd();
 
@@ -96,19 +112,41 @@ public:
 	void SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled);
 
 	// Weapon collision management
-	void EnableWeaponCollision();
-	void DisableWeaponCollision();
-	void ClearWeaponHitActors();
-
-	// Hit tracking system
-	bool HasAlreadyHit(AActor* Other) const { return HitActors.Contains(Other); }
-	void RecordHit(AActor* Other) { if (Other) { HitActors.AddUnique(Other); } }
+	virtual void EnableWeaponCollision() override;
+	virtual void DisableWeaponCollision() override;
 
     // Debug: disable all collisions on this enemy to isolate self-hit issues
     UPROPERTY(EditAnywhere, Category = "Debug")
     bool bDisableAllCollision = false;
 
+	// Patrol/chase/attack logic in Tick stays off while weapon collision is being debugged;
+	// the combat benchmark turns it on for the enemies it spawns
+	UPROPERTY(EditAnywhere, Category = "Debug")
+	bool bEnableCombatAI = false;
+
+	// Used by spawners that create enemies at runtime (set before FinishSpawning or FinishAcquire)
+	void SetPatrolTargets(const TArray<AActor*>& InPatrolTargets, AActor* InPatrolTarget);
+
+	//~ IPooledActor
+	virtual void OnPoolSpawned() override { bPooledInstance = true; }
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
 private:
+	// Controller, patrol, perception and weapon; BeginPlay for a fresh enemy, every hand-out for a pooled one
+	void StartEnemy();
+
+	void ClearHUDTarget();
+
+	// WeaponClass as the weapon component or a pooled weapon actor; nothing when already armed
+	void EquipWeapon();
+
+	// Closes the hit window and puts the weapon away: back to the pool, or the weapon component hidden
+	void ReleaseWeapon();
+
+	// Owned by UCombatActorPoolSubsystem, so BeginPlay leaves StartEnemy to OnAcquiredFromPool
+	bool bPooledInstance = false;
+
 	//Components
 	UPROPERTY(VisibleAnywhere)
 	UAIPerceptionComponent* AIPerception;
@@ -151,4 +189,7 @@ private:
 
 	UPROPERTY()
 	int32 AttackCount = 0;
+
+	// Patrol choice, patrol wait and death pose; seeded per session so replays are deterministic
+	FRandomStream RandomStream;
 };
@@ -14,6 +14,8 @@ class PROJECT_ECLIPSE_API UHealthBarComponent : public UWidgetComponent
 {
 	GENERATED_BODY()
 public:
+	virtual void InitWidget() override;
+
 	void SetHealthPercent(float Percent);
 private:
 	UPROPERTY()
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UHitboxComponent;
+
+/**
+ * What weapons, hitboxes and anim notifies need from the character that owns them.
+ * Plain C++ rather than a UINTERFACE: callers resolve it once (weapons when their owner is set) and then
+ * make ordinary virtual calls, instead of a cast per character class on every overlap.
+ * Implemented by ABaseCharacter; new character types override the virtuals instead of adding cast branches.
+ */
+class PROJECT_ECLIPSE_API ICombatant
+{
+public:
+	virtual ~ICombatant() = default;
+
+	// Hits outside an attack are ignored
+	virtual bool IsAttacking() const = 0;
+
+	// Swing id hits are recorded under; kicks and the equipped weapon share it
+	virtual uint32 GetSwingId() const = 0;
+	virtual void StartNewSwing() = 0;
+	virtual bool HasAlreadyHit(AActor* Other) const = 0;
+	virtual bool TryRecordHit(AActor* Other) = 0;
+
+	// Opens or closes the equipped weapon's hit window
+	virtual void EnableWeaponCollision() = 0;
+	virtual void DisableWeaponCollision() = 0;
+
+	virtual UHitboxComponent* GetHitboxes() const = 0;
+	virtual bool GetBakedAttackSegment(FName TrackName, FVector& OutStart, FVector& OutEnd) const = 0;
+
+	// One reflective cast, through IHitInterface; null for actors that can't fight
+	static ICombatant* Resolve(AActor* Actor);
+};
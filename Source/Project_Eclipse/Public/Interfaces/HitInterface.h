@@ -6,6 +6,10 @@
 #include "UObject/Interface.h"
 #include "HitInterface.generated.h"
 
+struct FCombatHitLedger;
+class UHurtboxComponent;
+class ICombatant;
+
 // This class does not need to be modified.
 UINTERFACE(MinimalAPI)
 class UHitInterface : public UInterface
@@ -23,4 +27,13 @@ class PROJECT_ECLIPSE_API IHitInterface
 	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
 public:
 	virtual void GetHit(const FVector& ImpactPoint)= 0;
+
+	// Swing de-duplication for attackers hitting this actor; actors without one are tracked by the weapon
+	virtual FCombatHitLedger* GetHitLedger() { return nullptr; }
+
+	// Per-bone narrow phase behind the actor's capsule; without one a capsule hit stands
+	virtual UHurtboxComponent* GetHurtbox() { return nullptr; }
+
+	// Actors that attack as well as take hits; see ICombatant::Resolve
+	virtual ICombatant* AsCombatant() { return nullptr; }
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PooledActor.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reset hooks for actors reused by UCombatActorPoolSubsystem.
+ * The pool detaches, hides and stops a released actor itself (collision, actor and component ticks);
+ * the hooks cover the gameplay state only the actor knows about.
+ */
+class PROJECT_ECLIPSE_API IPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	// Before BeginPlay on actors the pool creates. BeginPlay should leave activation to OnAcquiredFromPool,
+	// which runs every time the actor is handed out, including the first.
+	virtual void OnPoolSpawned() {}
+
+	// Back to the state of a fresh spawn. Transform, owner and instigator are already set.
+	virtual void OnAcquiredFromPool() = 0;
+
+	// Stop anything that could still reach the world: timers, AI, attached pooled actors, counters
+	virtual void OnReleasedToPool() = 0;
+};
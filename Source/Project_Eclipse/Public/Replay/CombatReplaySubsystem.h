@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatReplaySubsystem.generated.h"
+
+class AMyCharacter;
+
+// Player input actions captured by the replay system
+enum class ECombatInputAction : uint8
+{
+	Move,
+	Look,
+	Jump,
+	Attack1,
+	Attack2,
+	Attack3
+};
+
+/**
+ * Deterministic combat record and replay for A/B performance runs.
+ *   -EclipseRecord=Name  records player input per frame and the session seed to Saved/Replays/Name.ecrp
+ *   -EclipseReplay=Name  plays that session back headlessly (use with -nullrhi -unattended)
+ * Both modes run at a fixed timestep (-EclipseReplayFPS=, default 30). Enemies draw random numbers from
+ * per-actor streams seeded from the session seed, so the same fight plays out on both builds.
+ * When a replay ends the damage totals are checked against the recording and frame times are appended
+ * to Saved/Replays/Name.results.csv; the process exits non-zero if the fight diverged.
+ */
+UCLASS()
+class PROJECT_ECLIPSE_API UCombatReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Seed for an actor's random stream: deterministic while recording or replaying, random otherwise
+	static int32 MakeActorSeed(const UObject* WorldContextObject);
+
+	static void NotifyDamageTaken(const AActor* DamagedActor, float Damage);
+
+	bool IsRecording() const { return Mode == EMode::Recording; }
+	bool IsReplaying() const { return Mode == EMode::Replaying; }
+
+	void RecordInput(ECombatInputAction Action, const FVector2D& Value);
+
+	//~ USubsystem
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	enum class EMode : uint8
+	{
+		None,
+		Recording,
+		Replaying
+	};
+
+	struct FRecordedInput
+	{
+		uint32 Frame = 0;
+		ECombatInputAction Action = ECombatInputAction::Move;
+		FVector2f Value = FVector2f::ZeroVector;
+
+		friend FArchive& operator<<(FArchive& Ar, FRecordedInput& Input)
+		{
+			return Ar << Input.Frame << Input.Action << Input.Value;
+		}
+	};
+
+	void OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void ApplyReplayedInputs();
+	void FinishReplay();
+
+	// Same function reads and writes the file so the formats cannot drift apart
+	bool SerializeSession(FArchive& Ar);
+	bool SaveRecording();
+	bool LoadRecording();
+
+	EMode Mode = EMode::None;
+	FString SessionName;
+	FString FilePath;
+
+	int32 SessionSeed = 0;
+	int32 NextActorSeed = 0;
+	float FixedDeltaTime = 1.f / 30.f;
+
+	uint32 FrameIndex = 0;
+	TArray<FRecordedInput> Inputs;
+	int32 NextInputIndex = 0;
+
+	double DamageTotal = 0.0;
+	int32 DamageEvents = 0;
+
+	// Loaded from the recording, compared at the end of a replay
+	uint32 RecordedFrames = 0;
+	double RecordedDamageTotal = 0.0;
+	int32 RecordedDamageEvents = 0;
+
+	TArray<float> FrameTimesMs;
+	double LastTickStartSeconds = 0.0;
+
+	FDelegateHandle WorldTickStartHandle;
+	bool bFinished = false;
+};
@@ -4,14 +4,38 @@
 #include "GameFramework/Actor.h"
 #include "Characters/MyCharacter.h"
 #include "Components/BoxComponent.h"
+#include "WorldCollision.h"
+#include "Components/HurtboxComponent.h"
+#include "Interfaces/PooledActor.h"
 #include "Weapon.generated.h"
 
 class UStaticMeshComponent;
 class UBoxComponent;
 class USceneComponent;
+class ICombatant;
+
+UENUM(BlueprintType)
+enum class EWeaponHitMode : uint8
+{
+	// WeaponBox overlap events, each confirmed with a box trace along the blade
+	Overlap UMETA(DisplayName = "Overlap"),
+	// Sweep the blade from its previous to its current pose every frame the window is open
+	Continuous UMETA(DisplayName = "Continuous"),
+	// The blade is a shape on the owner's UHitboxComponent, queried together with its other attack shapes
+	Hitbox UMETA(DisplayName = "Hitbox")
+};
+
+UENUM(BlueprintType)
+enum class EWeaponTraceMode : uint8
+{
+	// Scene queries run immediately on the game thread
+	Blocking UMETA(DisplayName = "Blocking"),
+	// Scene queries go through the world's async trace API; hits are applied at the start of the next frame
+	Async UMETA(DisplayName = "Async")
+};
 
 UCLASS(Blueprintable)
-class PROJECT_ECLIPSE_API AWeapon : public AActor
+class PROJECT_ECLIPSE_API AWeapon : public AActor, public IPooledActor
 {
 	GENERATED_BODY()
 	
@@ -19,6 +43,13 @@ public:
 	AWeapon();
 	virtual void Tick(float DeltaTime) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void SetOwner(AActor* NewOwner) override;
+	virtual void OnRep_Owner() override;
+
+	//~ IPooledActor
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
@@ -36,31 +67,135 @@ protected:
 	UPROPERTY(EditAnywhere, Category = WeaponProperties)
 	float Damage = 20.f;
 
-	// Track which actors have been hit to prevent multiple hits
-	UPROPERTY()
-	TArray<AActor*> HitActors;
+	// Eclipse.Weapon.HitMode overrides this for A/B runs. Hitbox can only hit actors with a hit ledger
+	UPROPERTY(EditAnywhere, Category = WeaponProperties)
+	EWeaponHitMode HitMode = EWeaponHitMode::Overlap;
+
+	// Eclipse.Weapon.TraceMode overrides this for A/B runs
+	UPROPERTY(EditAnywhere, Category = WeaponProperties)
+	EWeaponTraceMode TraceMode = EWeaponTraceMode::Blocking;
+
+	// Continuous mode: minimum sweeps per frame; more are added so no step moves further than SweepMaxStepDistance
+	UPROPERTY(EditAnywhere, Category = WeaponProperties, meta = (EditCondition = "HitMode == EWeaponHitMode::Continuous", ClampMin = "1", ClampMax = "16"))
+	int32 SweepSubsteps = 1;
+
+	UPROPERTY(EditAnywhere, Category = WeaponProperties, meta = (EditCondition = "HitMode == EWeaponHitMode::Continuous", ClampMin = "1"))
+	float SweepMaxStepDistance = 30.f;
+
+	// Half width and depth of the swept blade box (the overlap mode trace uses 5); the capsule radius in hitbox mode
+	UPROPERTY(EditAnywhere, Category = WeaponProperties, meta = (EditCondition = "HitMode != EWeaponHitMode::Overlap", ClampMin = "0.5"))
+	float BladeHalfThickness = 5.f;
+
+    // Sweeps a box along the blade against the component the weapon box overlapped
+    bool BoxTrace(UPrimitiveComponent* Target, FHitResult& OutHit);
+
+    // Continuous mode: sweeps the blade volume between last frame's pose and this frame's
+    void SweepBlade();
+
+    // Blade ends in world space, from the owner's baked attack trajectory when it applies, otherwise from the trace components
+    void GetBladeSegment(FVector& OutStart, FVector& OutEnd) const;
+
+    // Hitbox mode: adds the blade to the owner's hitbox component and (de)activates it; false when the owner has none
+    bool SetHitboxBladeActive(bool bActive);
+
+    // Hits outside the owner's attack are ignored; owners that aren't combatants can always hit
+    bool IsOwnerAttacking() const;
+
+    // Shared by the overlap and continuous hit modes
+    bool CanHit(AActor* OwnerActor, AActor* HitActor, const UPrimitiveComponent* HitComponent);
+    bool TryRecordHit(AActor* OwnerActor, AActor* HitActor);
+    void ApplyHit(AActor* OwnerActor, AActor* HitActor, const FHitZoneResult& Zone);
 
-    // Helper function to perform box trace (debug drawing removed)
-    bool BoxTrace(FHitResult& OutHit);
+    // Async trace mode
+    void RequestAsyncBoxTrace();
+    void OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 
 	UFUNCTION()
 	void OnBoxOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-    UFUNCTION()
-    void OnBoxEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
 	UFUNCTION(BlueprintImplementableEvent)
 	void CreateFields(const FVector& FieldLocation);
 
 public:
 	FORCEINLINE UBoxComponent* GetWeaponBox() const { return WeaponBox; }
 	FORCEINLINE UStaticMeshComponent* GetSwordMesh() const { return SwordMesh; }
+	FORCEINLINE float GetDamage() const { return Damage; }
+	FORCEINLINE float GetBladeHalfThickness() const { return BladeHalfThickness; }
+
+	// Enables or disables the weapon box; owners go through this so open windows are counted
+	void SetCollisionWindowEnabled(ECollisionEnabled::Type CollisionEnabled);
+	EWeaponHitMode GetEffectiveHitMode() const;
+	EWeaponTraceMode GetEffectiveTraceMode() const;
+	FORCEINLINE bool IsCollisionWindowOpen() const { return bCollisionWindowOpen; }
 	
-	// Clear the hit actors list (call this when starting a new attack)
+	// Call after attaching actors to (or detaching them from) a weapon owner so its weapons rebuild their ignore lists.
+	// Changes to the owner's root or its direct children are also picked up without it; deeper ones need this call
+	static void NotifyAttachmentsChanged(AActor* OwnerActor);
+
+	// BoxTraceStart/BoxTraceEnd relative to the weapon root, i.e. in the space of the socket the weapon is attached to
+	void GetBladeLocalSegment(FVector& OutStart, FVector& OutEnd) const;
+
+	// Swing id hits are recorded under: the owning character's current attack, or one per window for other owners
+	uint32 GetSwingId() const;
+
+	// Starts a new swing so actors hit earlier can be hit again
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	void ClearHitActors();
 
 private:
-    // Recursively gather all actors attached to the given root actor
-    static void GatherAttachedActorsRecursive(AActor* RootActor, TSet<AActor*>& OutAttached);
+    // Owner as a combatant, resolved when the owner is set so the hit callbacks make one virtual call instead of casts
+    FORCEINLINE ICombatant* GetOwnerCombatant() const { return GetOwner() == CombatantOwner ? OwnerCombatant : nullptr; }
+    void ResolveOwnerCombatant();
+
+    ICombatant* OwnerCombatant = nullptr;
+
+    // Only compared with GetOwner(), so a destroyed owner can't be called through OwnerCombatant
+    const AActor* CombatantOwner = nullptr;
+
+    // Appends all actors attached to the given root actor, recursively
+    static void GatherAttachedActors(AActor* RootActor, TArray<AActor*>& OutAttached);
+
+    // This weapon, its owner, the owner's attach parents and everything attached to the owner.
+    // Used as the trace ignore list and the weapon box's move-ignore list; rebuilt when the owner or any attachment changes.
+    const TArray<AActor*>& GetOwnerIgnoreActors();
+
+    // Attach parent and attach child counts of the owner's root and its direct children, to spot attachments nobody notified
+    static uint32 GetAttachmentSignature(const AActor* OwnerActor);
+
+    UPROPERTY()
+    TArray<AActor*> OwnerIgnoreActors;
+
+    TWeakObjectPtr<AActor> IgnoreActorsOwner;
+    uint32 IgnoreActorsSignature = 0;
+    bool bIgnoreActorsDirty = true;
+
+    bool bCollisionWindowOpen = false;
+    bool bContinuousWindow = false;
+    bool bAsyncWindow = false;
+    bool bHitboxWindow = false;
+
+    // Incremented per window; async traces carry it so late results from an old window are dropped
+    uint32 WindowSerial = 0;
+    FTraceDelegate AsyncTraceDelegate;
+
+    // Swing id for owners that are not characters
+    uint32 WindowSwingId = 0;
+
+    // Victims without a hit ledger (props, blueprint-only actors) are remembered here for the current swing only
+    TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> UntrackedHits;
+    uint32 UntrackedHitsSwingId = 0;
+
+    static constexpr int32 MaxSweepSubsteps = 16;
+    static constexpr float BladeTraceHalfSize = 5.f;
+    FVector LastBladeStart = FVector::ZeroVector;
+    FVector LastBladeEnd = FVector::ZeroVector;
+
+    // Scratch buffers so the sweep does not allocate; only valid during SweepBlade
+    TArray<FHitResult> SweepStepHits;
+    struct FBladeHit
+    {
+        AActor* Victim;
+        FHitZoneResult Zone;
+    };
+    TArray<FBladeHit> SweepCandidates;
 };
@@ -0,0 +1,127 @@
+// Standalone reader for the game's live counter block (see EclipseLiveCounterLayout.h).
+// No engine dependency; build with
+//   Windows: cl /std:c++17 /O2 /EHsc EclipseCounterReader.cpp
+//   Linux:   g++ -std=c++17 -O2 EclipseCounterReader.cpp -o EclipseCounterReader -lrt
+//
+// Usage: EclipseCounterReader <pid> [IntervalMs=1000] [Samples=0 (forever)]
+// Prints one CSV line per sample.
+
+#include "../../Source/Project_Eclipse/Public/Diagnostics/EclipseLiveCounterLayout.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	class FMappedBlock
+	{
+	public:
+		explicit FMappedBlock(unsigned long ProcessId)
+		{
+			const std::string Name = std::string(ECLIPSE_LIVE_COUNTERS_REGION_PREFIX) + std::to_string(ProcessId);
+#if defined(_WIN32)
+			Mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, Name.c_str());
+			if (Mapping)
+			{
+				Block = static_cast<const FEclipseLiveCounterBlock*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, sizeof(FEclipseLiveCounterBlock)));
+			}
+#else
+			const int Fd = shm_open(("/" + Name).c_str(), O_RDONLY, 0);
+			if (Fd >= 0)
+			{
+				void* Address = mmap(nullptr, sizeof(FEclipseLiveCounterBlock), PROT_READ, MAP_SHARED, Fd, 0);
+				close(Fd);
+				if (Address != MAP_FAILED)
+				{
+					Block = static_cast<const FEclipseLiveCounterBlock*>(Address);
+				}
+			}
+#endif
+		}
+
+		~FMappedBlock()
+		{
+#if defined(_WIN32)
+			if (Block)
+			{
+				UnmapViewOfFile(Block);
+			}
+			if (Mapping)
+			{
+				CloseHandle(Mapping);
+			}
+#else
+			if (Block)
+			{
+				munmap(const_cast<FEclipseLiveCounterBlock*>(Block), sizeof(FEclipseLiveCounterBlock));
+			}
+#endif
+		}
+
+		const FEclipseLiveCounterBlock* Get() const { return Block; }
+
+	private:
+		const FEclipseLiveCounterBlock* Block = nullptr;
+#if defined(_WIN32)
+		HANDLE Mapping = nullptr;
+#endif
+	};
+}
+
+int main(int Argc, char** Argv)
+{
+	if (Argc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <pid> [IntervalMs=1000] [Samples=0]\n", Argv[0]);
+		return 2;
+	}
+
+	const unsigned long ProcessId = std::strtoul(Argv[1], nullptr, 10);
+	const int IntervalMs = Argc > 2 ? std::atoi(Argv[2]) : 1000;
+	const long Samples = Argc > 3 ? std::atol(Argv[3]) : 0;
+
+	FMappedBlock Mapped(ProcessId);
+	const FEclipseLiveCounterBlock* Block = Mapped.Get();
+	if (!Block)
+	{
+		std::fprintf(stderr, "No live counters for process %lu (was it started with -EclipseLiveCounters?)\n", ProcessId);
+		return 1;
+	}
+
+	if (Block->Magic != FEclipseLiveCounterBlock::ExpectedMagic || Block->Version != FEclipseLiveCounterBlock::CurrentVersion
+		|| Block->Size < sizeof(FEclipseLiveCounterBlock))
+	{
+		std::fprintf(stderr, "Unexpected counter block (magic %08x, version %u, size %u)\n", Block->Magic, Block->Version, Block->Size);
+		return 1;
+	}
+
+	std::printf("Frame,FrameTimeMs,GameThreadMs,LiveEnemies,ActiveWeaponWindows,TracesPerFrame,OverlapsPerFrame,DamageEventsPerFrame,DamageEventsPerSecond,PooledInUse,PooledCapacity\n");
+	for (long Sample = 0; Samples == 0 || Sample < Samples; ++Sample)
+	{
+		FEclipseLiveCounterBlock Snapshot;
+		if (TryReadEclipseLiveCounters(*Block, Snapshot))
+		{
+			std::printf("%llu,%.3f,%.3f,%u,%u,%u,%u,%u,%.2f,%u,%u\n",
+				static_cast<unsigned long long>(Snapshot.Frame), Snapshot.FrameTimeMs, Snapshot.GameThreadMs,
+				Snapshot.LiveEnemies, Snapshot.ActiveWeaponWindows, Snapshot.TracesPerFrame, Snapshot.OverlapsPerFrame,
+				Snapshot.DamageEventsPerFrame, Snapshot.DamageEventsPerSecond, Snapshot.PooledInUse, Snapshot.PooledCapacity);
+			std::fflush(stdout);
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(IntervalMs));
+	}
+
+	return 0;
+}